@@ -0,0 +1,326 @@
+#include "benchmark.hxx"
+
+#include <StormByte/platform.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#ifdef LINUX
+#include <sched.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifndef STORMBYTE_BUFFER_VERSION
+#define STORMBYTE_BUFFER_VERSION "unknown"
+#endif
+
+#ifndef STORMBYTE_BUFFER_BUILD_TYPE
+#define STORMBYTE_BUFFER_BUILD_TYPE "unknown"
+#endif
+
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	[[noreturn]] void usage(const char* program, const std::string& error) {
+		if (!error.empty()) std::cerr << program << ": " << error << '\n';
+		std::cerr << "Usage: " << program << " [--json <file>] [--repetitions <n>] [--cpu <list>]\n"
+				  << "  --json <file>        Write machine readable results to <file>\n"
+				  << "  --repetitions <n>    Run the whole suite <n> times (default 1)\n"
+				  << "  --cpu <list>         Pin to CPUs, e.g. 2 or 0-3,8\n";
+		std::exit(error.empty() ? 0 : 2);
+	}
+
+	bool parseCpus(const std::string& list, std::vector<int>& cpus) {
+		std::stringstream ss(list);
+		std::string item;
+		while (std::getline(ss, item, ',')) {
+			try {
+				const auto dash = item.find('-');
+				if (dash == std::string::npos) {
+					cpus.push_back(std::stoi(item));
+				} else {
+					const int first = std::stoi(item.substr(0, dash));
+					const int last = std::stoi(item.substr(dash + 1));
+					if (last < first) return false;
+					for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+				}
+			} catch (const std::exception&) {
+				return false;
+			}
+		}
+		return !cpus.empty();
+	}
+
+	std::string escape(const std::string& in) {
+		std::string out;
+		out.reserve(in.size());
+		for (char c : in) {
+			switch (c) {
+				case '"':	out += "\\\""; break;
+				case '\\':	out += "\\\\"; break;
+				case '\n':	out += "\\n"; break;
+				case '\t':	out += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						char buf[8];
+						std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+						out += buf;
+					} else {
+						out += c;
+					}
+			}
+		}
+		return out;
+	}
+
+	std::string number(double value) {
+		if (!std::isfinite(value)) return "null";
+		std::ostringstream out;
+		out.precision(17);
+		out << value;
+		return out.str();
+	}
+
+	std::string hostname() {
+		#ifdef LINUX
+		char name[256] = {};
+		if (gethostname(name, sizeof(name) - 1) == 0) return name;
+		#else
+		if (const char* name = std::getenv("COMPUTERNAME")) return name;
+		#endif
+		return "unknown";
+	}
+
+	std::string operatingSystem() {
+		#ifdef LINUX
+		utsname info;
+		if (uname(&info) == 0) return std::string(info.sysname) + " " + info.release + " " + info.machine;
+		return "Linux";
+		#else
+		return "Windows";
+		#endif
+	}
+
+	std::string cpuModel() {
+		#ifdef LINUX
+		std::ifstream cpuinfo("/proc/cpuinfo");
+		std::string line;
+		while (std::getline(cpuinfo, line)) {
+			if (line.rfind("model name", 0) == 0) {
+				const auto colon = line.find(':');
+				if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+			}
+		}
+		#endif
+		return "unknown";
+	}
+
+	std::string compiler() {
+		#if defined(__clang__)
+		return std::string("clang ") + __clang_version__;
+		#elif defined(__GNUC__)
+		return std::string("gcc ") + __VERSION__;
+		#elif defined(_MSC_VER)
+		return "msvc " + std::to_string(_MSC_VER);
+		#else
+		return "unknown";
+		#endif
+	}
+
+	std::string timestamp() {
+		const std::time_t now = std::time(nullptr);
+		std::tm utc {};
+		#ifdef WINDOWS
+		gmtime_s(&utc, &now);
+		#else
+		gmtime_r(&now, &utc);
+		#endif
+		char buf[32];
+		std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &utc);
+		return buf;
+	}
+
+	struct Aggregate {
+		const Result* first = nullptr;
+		std::vector<double> ns;
+		std::vector<double> throughput;
+		std::vector<double> allocations;
+		std::map<std::string, std::vector<double>> metrics;
+	};
+
+	double mean(const std::vector<double>& v) {
+		if (v.empty()) return 0;
+		double sum = 0;
+		for (double x : v) sum += x;
+		return sum / static_cast<double>(v.size());
+	}
+
+	double stddev(const std::vector<double>& v) {
+		if (v.size() < 2) return 0;
+		const double m = mean(v);
+		double sum = 0;
+		for (double x : v) sum += (x - m) * (x - m);
+		return std::sqrt(sum / static_cast<double>(v.size() - 1));
+	}
+}
+
+Options StormByte::Buffer::Bench::ParseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		auto value = [&]() -> std::string {
+			if (i + 1 >= argc) usage(argv[0], "missing value for " + arg);
+			return argv[++i];
+		};
+		if (arg == "--json") {
+			options.json = value();
+		} else if (arg == "--repetitions") {
+			const std::string v = value();
+			try {
+				options.repetitions = std::stoul(v);
+			} catch (const std::exception&) {
+				options.repetitions = 0;
+			}
+			if (options.repetitions == 0) usage(argv[0], "invalid repetitions: " + v);
+		} else if (arg == "--cpu") {
+			const std::string v = value();
+			if (!parseCpus(v, options.cpus)) usage(argv[0], "invalid cpu list: " + v);
+		} else if (arg == "--help" || arg == "-h") {
+			usage(argv[0], "");
+		} else {
+			usage(argv[0], "unknown argument " + arg);
+		}
+	}
+	return options;
+}
+
+bool StormByte::Buffer::Bench::PinToCpus(const std::vector<int>& cpus) {
+	#ifdef LINUX
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int cpu : cpus) {
+		if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+		CPU_SET(cpu, &set);
+	}
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+	#else
+	(void)cpus;
+	return false;
+	#endif
+}
+
+MemoryUsage StormByte::Buffer::Bench::Memory() noexcept {
+	MemoryUsage usage;
+	#ifdef LINUX
+	std::ifstream statm("/proc/self/statm");
+	std::size_t pages = 0, resident = 0;
+	if (statm >> pages >> resident)
+		usage.rss = resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	#endif
+	#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	const struct mallinfo2 info = mallinfo2();
+	usage.heap = info.uordblks + info.hblkhd;
+	#endif
+	return usage;
+}
+
+void StormByte::Buffer::Bench::TrimHeap() noexcept {
+	#if defined(__GLIBC__)
+	malloc_trim(0);
+	#endif
+}
+
+Report::Report(std::string benchmark, Options options): m_benchmark(std::move(benchmark)), m_options(std::move(options)) {
+	if (!m_options.cpus.empty()) {
+		m_pinned = PinToCpus(m_options.cpus);
+		if (!m_pinned) std::cerr << m_benchmark << ": warning: could not pin to the requested CPUs\n";
+	}
+}
+
+int Report::Finish() const {
+	if (m_options.json.empty()) return 0;
+	std::ofstream out(m_options.json);
+	if (!out) {
+		std::cerr << m_benchmark << ": cannot open " << m_options.json << '\n';
+		return 1;
+	}
+	WriteJson(out);
+	return out.good() ? 0 : 1;
+}
+
+void Report::WriteJson(std::ostream& out) const {
+	// Aggregate repetitions keeping first-seen order
+	std::vector<std::string> order;
+	std::map<std::string, Aggregate> aggregates;
+	for (const auto& r : m_results) {
+		const std::string key = r.name + "/" + std::to_string(r.payload);
+		auto [it, inserted] = aggregates.try_emplace(key);
+		if (inserted) {
+			order.push_back(key);
+			it->second.first = &r;
+		}
+		it->second.ns.push_back(r.ns_per_op);
+		it->second.throughput.push_back(r.bytes_per_second);
+		it->second.allocations.push_back(r.allocations_per_op);
+		for (const auto& [name, value] : r.metrics) it->second.metrics[name].push_back(value);
+	}
+
+	out << "{\n"
+		<< "  \"schema\": 1,\n"
+		<< "  \"benchmark\": \"" << escape(m_benchmark) << "\",\n"
+		<< "  \"environment\": {\n"
+		<< "    \"timestamp\": \"" << timestamp() << "\",\n"
+		<< "    \"hostname\": \"" << escape(hostname()) << "\",\n"
+		<< "    \"os\": \"" << escape(operatingSystem()) << "\",\n"
+		<< "    \"cpu_model\": \"" << escape(cpuModel()) << "\",\n"
+		<< "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n"
+		<< "    \"compiler\": \"" << escape(compiler()) << "\",\n"
+		<< "    \"build_type\": \"" << escape(STORMBYTE_BUFFER_BUILD_TYPE) << "\",\n"
+		<< "    \"library_version\": \"" << escape(STORMBYTE_BUFFER_VERSION) << "\",\n"
+		<< "    \"repetitions\": " << m_options.repetitions << ",\n"
+		<< "    \"pinned_cpus\": [";
+	if (m_pinned) {
+		for (std::size_t i = 0; i < m_options.cpus.size(); ++i)
+			out << (i ? ", " : "") << m_options.cpus[i];
+	}
+	out << "]\n"
+		<< "  },\n"
+		<< "  \"results\": [";
+
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		const Aggregate& a = aggregates.at(order[i]);
+		const Result& r = *a.first;
+		out << (i ? ",\n" : "\n")
+			<< "    {\n"
+			<< "      \"name\": \"" << escape(r.name) << "\",\n"
+			<< "      \"payload\": " << r.payload << ",\n"
+			<< "      \"iterations\": " << r.iterations << ",\n"
+			<< "      \"bytes_per_op\": " << r.bytes_per_op << ",\n"
+			<< "      \"ns_per_op\": { \"mean\": " << number(mean(a.ns))
+			<< ", \"min\": " << number(*std::min_element(a.ns.begin(), a.ns.end()))
+			<< ", \"max\": " << number(*std::max_element(a.ns.begin(), a.ns.end()))
+			<< ", \"stddev\": " << number(stddev(a.ns))
+			<< ", \"samples\": [";
+		for (std::size_t s = 0; s < a.ns.size(); ++s) out << (s ? ", " : "") << number(a.ns[s]);
+		out << "] },\n"
+			<< "      \"bytes_per_second\": " << number(mean(a.throughput)) << ",\n"
+			<< "      \"allocations_per_op\": " << number(mean(a.allocations)) << ",\n"
+			<< "      \"metrics\": {";
+		std::size_t m = 0;
+		for (const auto& [name, values] : a.metrics)
+			out << (m++ ? ", " : " ") << '"' << escape(name) << "\": " << number(mean(values));
+		out << (m ? " }" : "}") << "\n"
+			<< "    }";
+	}
+	out << "\n  ]\n}\n";
+}
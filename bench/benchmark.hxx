@@ -0,0 +1,263 @@
+#pragma once
+
+#include <alloc_counter.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace Bench
+ * @brief Support code shared by the StormByte Buffer benchmark executables.
+ */
+namespace StormByte::Buffer::Bench {
+	using Test::AllocationStats;
+	using Test::Allocations;
+
+	/**
+	 * @struct Result
+	 * @brief Outcome of a single measured benchmark case.
+	 */
+	struct Result {
+		std::string name;					///< Benchmark case name
+		std::size_t payload			= 0;	///< Payload size in bytes used by the case
+		std::size_t iterations		= 0;	///< Number of timed operations
+		std::size_t bytes_per_op	= 0;	///< Bytes moved by each operation (0 if not meaningful)
+		double ns_per_op			= 0;	///< Mean wall time per operation in nanoseconds
+		double bytes_per_second		= 0;	///< Throughput, derived from bytes_per_op
+		double allocations_per_op	= 0;	///< Mean global allocations per operation
+		std::vector<std::pair<std::string, double>> metrics;	///< Case specific extra figures (latency percentiles, ...)
+	};
+
+	/** @brief Clock used for every measurement. */
+	using Clock = std::chrono::steady_clock;
+
+	/** @brief Payload sizes exercised by the per-size benchmarks (1 B to 16 MiB). */
+	inline const std::vector<std::size_t> PayloadSizes {
+		1, 16, 256, 4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024
+	};
+
+	/**
+	 * @brief Compute how many iterations a case should run for a payload size.
+	 * @param payload Payload size in bytes.
+	 * @return Iteration count bounded so every case moves roughly the same amount of data.
+	 */
+	inline std::size_t Iterations(std::size_t payload) noexcept {
+		constexpr std::size_t budget = 64 * 1024 * 1024;
+		return std::clamp<std::size_t>(budget / std::max<std::size_t>(payload, 1), 4, 200000);
+	}
+
+	/**
+	 * @brief Keep a value observable so the compiler cannot drop the work producing it.
+	 */
+	template<typename T>
+	inline void DoNotOptimize(const T& value) noexcept {
+		static volatile const void* sink;
+		sink = static_cast<const void*>(&value);
+	}
+
+	/**
+	 * @brief Build a result from raw measurements.
+	 * @param name Case name.
+	 * @param payload Payload size in bytes.
+	 * @param bytes_per_op Bytes moved per operation.
+	 * @param iterations Number of operations performed.
+	 * @param ns Total wall time in nanoseconds.
+	 * @param allocations Global allocations observed while running.
+	 * @return Result with derived per-operation figures filled in.
+	 */
+	inline Result MakeResult(const std::string& name, std::size_t payload, std::size_t bytes_per_op,
+							 std::size_t iterations, double ns, std::size_t allocations) {
+		Result result;
+		result.name = name;
+		result.payload = payload;
+		result.iterations = iterations;
+		result.bytes_per_op = bytes_per_op;
+		result.ns_per_op = iterations > 0 ? ns / static_cast<double>(iterations) : 0;
+		result.bytes_per_second = ns > 0 ? static_cast<double>(bytes_per_op * iterations) * 1e9 / ns : 0;
+		result.allocations_per_op = iterations > 0 ? static_cast<double>(allocations) / static_cast<double>(iterations) : 0;
+		return result;
+	}
+
+	/**
+	 * @brief Latency distribution summary in nanoseconds.
+	 */
+	struct Percentiles {
+		double p50	= 0;
+		double p99	= 0;
+		double p999	= 0;
+		double max	= 0;
+	};
+
+	/**
+	 * @brief Compute latency percentiles.
+	 * @param samples Latency samples in nanoseconds; sorted in place.
+	 * @return Nearest-rank percentiles, all zero when there are no samples.
+	 */
+	inline Percentiles ComputePercentiles(std::vector<double>& samples) {
+		Percentiles result;
+		if (samples.empty()) return result;
+		std::sort(samples.begin(), samples.end());
+		auto rank = [&](double p) {
+			const std::size_t n = samples.size();
+			const std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(n));
+			return samples[std::min(idx, n - 1)];
+		};
+		result.p50 = rank(0.50);
+		result.p99 = rank(0.99);
+		result.p999 = rank(0.999);
+		result.max = samples.back();
+		return result;
+	}
+
+	/**
+	 * @brief Append percentile metrics to a result using @p prefix for their names.
+	 */
+	inline void AddPercentiles(Result& result, const std::string& prefix, const Percentiles& p) {
+		result.metrics.emplace_back(prefix + "_p50_ns", p.p50);
+		result.metrics.emplace_back(prefix + "_p99_ns", p.p99);
+		result.metrics.emplace_back(prefix + "_p999_ns", p.p999);
+		result.metrics.emplace_back(prefix + "_max_ns", p.max);
+	}
+
+	/**
+	 * @brief Measure an operation.
+	 * @param name Case name.
+	 * @param payload Payload size in bytes.
+	 * @param bytes_per_op Bytes moved per call to @p op.
+	 * @param iterations Number of timed calls.
+	 * @param setup Untimed preparation executed once before the timed loop.
+	 * @param op Operation to measure, called with the iteration index.
+	 * @return Timing and allocation figures for the case.
+	 */
+	template<typename Setup, typename Operation>
+	Result Measure(const std::string& name, std::size_t payload, std::size_t bytes_per_op,
+				   std::size_t iterations, Setup&& setup, Operation&& op) {
+		setup();
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+			op(i);
+		const auto end = Clock::now();
+		const AllocationStats delta = Allocations() - before;
+
+		const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+		return MakeResult(name, payload, bytes_per_op, iterations, ns, delta.allocations);
+	}
+
+	/**
+	 * @struct Options
+	 * @brief Command line options understood by every benchmark executable.
+	 *
+	 * @code
+	 * FIFOBenchmark [--json <file>] [--repetitions <n>] [--cpu <list>]
+	 * @endcode
+	 * @c --cpu accepts a comma separated list of CPUs and ranges (e.g. @c 2 or @c 0-3,8).
+	 */
+	struct Options {
+		std::string json;					///< Path of the JSON report; empty disables it
+		std::size_t repetitions		= 1;	///< Number of times the whole suite is run
+		std::vector<int> cpus;				///< CPUs the process is pinned to; empty means no pinning
+	};
+
+	/**
+	 * @brief Parse the command line.
+	 * @return Parsed options; exits the process with a usage message on invalid input.
+	 */
+	Options ParseOptions(int argc, char** argv);
+
+	/**
+	 * @brief Pin the calling thread (and threads it creates afterwards) to a CPU set.
+	 * @param cpus CPUs to run on.
+	 * @return true on success, false if pinning failed or is unsupported on this platform.
+	 */
+	bool PinToCpus(const std::vector<int>& cpus);
+
+	/**
+	 * @struct MemoryUsage
+	 * @brief Process memory figures used by the footprint benchmarks.
+	 */
+	struct MemoryUsage {
+		std::size_t rss		= 0;	///< Resident set size in bytes (/proc/self/statm; 0 if unavailable)
+		std::size_t heap	= 0;	///< Bytes handed out by malloc and not freed (mallinfo2; 0 if unavailable)
+	};
+
+	/**
+	 * @brief Current process memory usage.
+	 */
+	MemoryUsage Memory() noexcept;
+
+	/**
+	 * @brief Return free heap memory to the OS where supported (malloc_trim), so cases
+	 *        start from a comparable baseline.
+	 */
+	void TrimHeap() noexcept;
+
+	/**
+	 * @class Report
+	 * @brief Collects results, prints them as an aligned table and optionally writes a JSON report.
+	 *
+	 * @details Results with the same name and payload (one per repetition) are aggregated in
+	 *          the JSON output: ns/op is reported with mean, min, max and standard deviation so
+	 *          a comparison tool can tell noise from regressions.
+	 */
+	class Report {
+		public:
+			/**
+			 * @brief Create a report for a benchmark executable.
+			 * @param benchmark Executable name, recorded in the JSON output.
+			 * @param options Parsed command line options; CPU pinning is applied here.
+			 */
+			Report(std::string benchmark, Options options);
+
+			void Add(Result result) {
+				Print(std::cout, result);
+				m_results.push_back(std::move(result));
+			}
+
+			const std::vector<Result>& Results() const noexcept { return m_results; }
+
+			/** @brief Number of repetitions requested on the command line. */
+			std::size_t Repetitions() const noexcept { return m_options.repetitions; }
+
+			/**
+			 * @brief Write the JSON report if one was requested.
+			 * @return Process exit code: 0 on success, 1 if the report could not be written.
+			 */
+			int Finish() const;
+
+			static void PrintHeader(std::ostream& out) {
+				out << std::left << std::setw(36) << "benchmark"
+					<< std::right << std::setw(12) << "payload"
+					<< std::setw(12) << "iters"
+					<< std::setw(14) << "ns/op"
+					<< std::setw(14) << "MiB/s"
+					<< std::setw(12) << "allocs/op" << '\n';
+			}
+
+			static void Print(std::ostream& out, const Result& r) {
+				out << std::left << std::setw(36) << r.name
+					<< std::right << std::setw(12) << r.payload
+					<< std::setw(12) << r.iterations
+					<< std::setw(14) << std::fixed << std::setprecision(1) << r.ns_per_op
+					<< std::setw(14) << std::setprecision(1) << r.bytes_per_second / (1024.0 * 1024.0)
+					<< std::setw(12) << std::setprecision(3) << r.allocations_per_op;
+				for (const auto& [key, value] : r.metrics)
+					out << "  " << key << '=' << std::setprecision(1) << value;
+				out << '\n';
+			}
+
+		private:
+			std::string m_benchmark;
+			Options m_options;
+			bool m_pinned = false;
+			std::vector<Result> m_results;
+
+			void WriteJson(std::ostream& out) const;
+	};
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Compare two StormByte Buffer benchmark JSON reports.
+
+Usage: compare.py [options] <baseline.json> <candidate.json>
+
+Cases are matched by name and payload. The minimum ns/op over all repetitions
+is compared, since it is the least noisy estimator. A case regresses when the
+candidate is slower than the baseline by more than the larger of:
+  - the fixed relative threshold (--threshold, default 5%), and
+  - the observed noise (--noise-factor times the worse coefficient of
+    variation of both runs), when repetitions are available.
+A case also regresses when allocations/op grow by more than --alloc-threshold.
+
+Exit status: 0 when there are no significant regressions, 1 when there are,
+2 on usage or input errors.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    try:
+        with open(path, encoding="utf-8") as f:
+            report = json.load(f)
+    except (OSError, ValueError) as e:
+        sys.exit(f"compare.py: cannot read {path}: {e}")
+    if report.get("schema") != 1:
+        sys.exit(f"compare.py: {path}: unsupported schema {report.get('schema')}")
+    return report
+
+
+def cases(report):
+    return {f"{r['name']}/{r['payload']}": r for r in report["results"]}
+
+
+def variation(stats):
+    mean = stats.get("mean") or 0
+    return (stats.get("stddev") or 0) / mean if mean > 0 else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two benchmark JSON reports.")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="minimum relative slowdown reported as regression (default 0.05)")
+    parser.add_argument("--noise-factor", type=float, default=3.0,
+                        help="multiple of the coefficient of variation treated as noise (default 3)")
+    parser.add_argument("--alloc-threshold", type=float, default=0.01,
+                        help="absolute allocations/op increase reported as regression (default 0.01)")
+    parser.add_argument("--all", action="store_true", help="print unchanged cases too")
+    args = parser.parse_args()
+
+    base_report, cand_report = load(args.baseline), load(args.candidate)
+    base, cand = cases(base_report), cases(cand_report)
+
+    for key in ("cpu_model", "compiler", "build_type", "pinned_cpus"):
+        b, c = base_report["environment"].get(key), cand_report["environment"].get(key)
+        if b != c:
+            print(f"warning: environment differs in {key}: {b!r} vs {c!r}")
+
+    regressions = improvements = 0
+    print(f"{'benchmark':<48} {'base ns/op':>14} {'new ns/op':>14} {'delta':>9} {'limit':>8}  status")
+    for key in base:
+        if key not in cand:
+            print(f"{key:<48} {'':>14} {'':>14} {'':>9} {'':>8}  missing")
+            continue
+        b, c = base[key], cand[key]
+        b_ns, c_ns = b["ns_per_op"]["min"], c["ns_per_op"]["min"]
+        if not b_ns:
+            continue
+        delta = (c_ns - b_ns) / b_ns
+        noise = args.noise_factor * max(variation(b["ns_per_op"]), variation(c["ns_per_op"]))
+        limit = max(args.threshold, noise)
+        alloc_delta = (c.get("allocations_per_op") or 0) - (b.get("allocations_per_op") or 0)
+
+        status = "ok"
+        if delta > limit:
+            status = "REGRESSION"
+        elif alloc_delta > args.alloc_threshold:
+            status = f"REGRESSION (allocs/op +{alloc_delta:.3f})"
+        elif delta < -limit:
+            status = "improved"
+
+        if status.startswith("REGRESSION"):
+            regressions += 1
+        elif status == "improved":
+            improvements += 1
+        if args.all or status != "ok":
+            print(f"{key:<48} {b_ns:>14.1f} {c_ns:>14.1f} {delta:>+8.1%} {limit:>7.1%}  {status}")
+
+    for key in cand:
+        if key not in base:
+            print(f"{key:<48} {'':>14} {'':>14} {'':>9} {'':>8}  new")
+
+    print(f"\n{len(base)} cases, {regressions} regressions, {improvements} improvements")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
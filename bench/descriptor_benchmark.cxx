@@ -0,0 +1,135 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/descriptor.hxx>
+#include <StormByte/buffer/pipeline.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::Pipeline;
+using StormByte::Buffer::Producer;
+using StormByte::Buffer::SharedFIFO;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	// Fits the default 64 KiB pipe capacity, so no write below ever blocks
+	const std::vector<std::size_t> ChunkSizes { 256, 4 * 1024, 64 * 1024 };
+	// Files copied by a two stage pipeline, cached by the kernel after the first copy
+	const std::vector<std::size_t> FileSizes { 1024 * 1024, 16 * 1024 * 1024 };
+
+#if defined(__linux__)
+	// Relays one chunk per operation from one pipe to another through a buffer.
+	// Filling the source pipe and draining the sink pipe is the same for every case.
+	template<class Buffer = FIFO, class Relay>
+	void bench_relay(Report& report, const std::string& name, std::size_t chunk, Relay relay) {
+		int source[2], sink[2];
+		if (::pipe(source) != 0 || ::pipe(sink) != 0) return;
+		const std::vector<std::byte> payload(chunk, std::byte { 0x42 });
+		std::vector<std::byte> scratch(chunk);
+		Buffer fifo;
+		fifo.Reserve(2 * chunk);
+		report.Add(Measure(name, chunk, chunk, Iterations(chunk),
+			[&] {},
+			[&](std::size_t) {
+				(void)!::write(source[1], payload.data(), chunk);
+				relay(fifo, source[0], sink[1], scratch);
+				(void)!::read(sink[0], scratch.data(), chunk);
+				DoNotOptimize(scratch);
+			}));
+		for (int fd : { source[0], source[1], sink[0], sink[1] }) ::close(fd);
+	}
+
+	// read() into a vector then Write(); Extract() into a vector then write()
+	void bench_copy(Report& report, std::size_t chunk) {
+		bench_relay(report, "FIFO::ReadWriteExtract", chunk, [chunk](FIFO& fifo, int in, int out, std::vector<std::byte>& scratch) {
+			const ssize_t n = ::read(in, scratch.data(), chunk);
+			fifo.Write(std::span<const std::byte>(scratch.data(), static_cast<std::size_t>(n)));
+			auto data = fifo.Extract(chunk);
+			(void)!::write(out, data->data(), data->size());
+		});
+	}
+
+	// readv() straight into the free storage, writev() straight out of the stored bytes
+	void bench_vectored(Report& report, std::size_t chunk) {
+		bench_relay(report, "FIFO::ReadFromWriteTo", chunk, [chunk](FIFO& fifo, int in, int out, std::vector<std::byte>&) {
+			(void)fifo.ReadFrom(in, chunk);
+			(void)fifo.WriteTo(out, chunk);
+		});
+	}
+
+	// splice() through the buffer's kernel pipe: the payload never reaches user space
+	void bench_splice(Report& report, std::size_t chunk) {
+		bench_relay<SharedFIFO>(report, "SharedFIFO::ReadFromWriteTo", chunk, [chunk](SharedFIFO& fifo, int in, int out, std::vector<std::byte>&) {
+			(void)fifo.ReadFrom(in, chunk);
+			(void)fifo.WriteTo(out, chunk);
+		});
+		bench_relay<SharedFIFO>(report, "SharedFIFO::SpliceFromSpliceTo", chunk, [chunk](SharedFIFO& fifo, int in, int out, std::vector<std::byte>&) {
+			(void)fifo.SpliceFrom(in, chunk);
+			(void)fifo.SpliceTo(out, chunk);
+		});
+	}
+
+	// Copies a temporary file into another through a source and a sink stage, one file per operation
+	template<class Source, class Sink>
+	void bench_file_copy(Report& report, const std::string& name, std::size_t size, Source source, Sink sink) {
+		char source_path[] = "/tmp/stormbyte-bench-sourceXXXXXX";
+		char sink_path[] = "/tmp/stormbyte-bench-sinkXXXXXX";
+		const int in = ::mkstemp(source_path), out = ::mkstemp(sink_path);
+		if (in >= 0 && out >= 0) {
+			const std::vector<std::byte> payload(size, std::byte { 0x42 });
+			(void)!::write(in, payload.data(), size);
+			Pipeline pipeline;
+			pipeline.AddPipe(source(in));
+			pipeline.AddPipe(sink(out));
+			report.Add(Measure(name, size, size, Iterations(size),
+				[&] {},
+				[&](std::size_t) {
+					::lseek(in, 0, SEEK_SET);
+					::lseek(out, 0, SEEK_SET);
+					Producer input;
+					input.Close();
+					auto output = pipeline.Process(input.Consumer(), StormByte::Buffer::ExecutionMode::Sync, nullptr);
+					DoNotOptimize(output);
+				}));
+		}
+		for (int fd : { in, out }) if (fd >= 0) ::close(fd);
+		::unlink(source_path);
+		::unlink(sink_path);
+	}
+
+	// Blocking readv()/writev() stages against io_uring stages with reads and writes in flight
+	void bench_file_stages(Report& report, std::size_t size) {
+		bench_file_copy(report, "Pipeline::DescriptorFileCopy", size,
+			[](int fd) { return StormByte::Buffer::DescriptorSource(fd, 64 * 1024); },
+			[](int fd) { return StormByte::Buffer::DescriptorSink(fd); });
+		if (!StormByte::Buffer::UringAvailable()) return;
+		bench_file_copy(report, "Pipeline::UringFileCopy", size,
+			[](int fd) { return StormByte::Buffer::UringSource(fd); },
+			[](int fd) { return StormByte::Buffer::UringSink(fd); });
+	}
+#endif
+}
+
+int main(int argc, char** argv) {
+	Report report("DescriptorBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+#if defined(__linux__)
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		for (std::size_t chunk : ChunkSizes) {
+			bench_copy(report, chunk);
+			bench_vectored(report, chunk);
+			bench_splice(report, chunk);
+		}
+		for (std::size_t size : FileSizes) bench_file_stages(report, size);
+	}
+#endif
+	return report.Finish();
+}
@@ -0,0 +1,152 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/fifo.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+#include <StormByte/buffer/slab_pool.hxx>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::SharedFIFO;
+using StormByte::Buffer::SlabPool;
+using StormByte::Buffer::Position;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	// FIFO whose storage comes from the process wide slab pool
+	struct PooledFIFO final: public FIFO {
+		PooledFIFO() noexcept: FIFO(&SlabPool::Instance()) {}
+	};
+
+	std::vector<std::byte> makePayload(std::size_t size) {
+		std::vector<std::byte> data(size);
+		for (std::size_t i = 0; i < size; ++i) data[i] = static_cast<std::byte>('A' + (i % 26));
+		return data;
+	}
+
+	// Fills a buffer with `count` copies of `payload` outside of the timed region
+	template<class Buffer>
+	void prefill(Buffer& buffer, const std::vector<std::byte>& payload, std::size_t count) {
+		for (std::size_t i = 0; i < count; ++i) buffer.Write(payload);
+	}
+
+	template<class Buffer>
+	void bench_write(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		const std::size_t iters = Iterations(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::Write", size, size, iters,
+			[&] {},
+			[&](std::size_t) { buffer->Write(payload); }));
+	}
+
+	template<class Buffer>
+	void bench_read(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		const std::size_t iters = Iterations(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::Read", size, size, iters,
+			[&] { prefill(*buffer, payload, 1); },
+			[&](std::size_t) {
+				buffer->Seek(0, Position::Absolute);
+				auto data = buffer->Read(size);
+				DoNotOptimize(data);
+			}));
+	}
+
+	template<class Buffer>
+	void bench_extract(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		const std::size_t iters = Iterations(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::Extract", size, size, iters,
+			[&] { prefill(*buffer, payload, iters); },
+			[&](std::size_t) {
+				auto data = buffer->Extract(size);
+				DoNotOptimize(data);
+			}));
+	}
+
+	template<class Buffer>
+	void bench_seek(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		const std::size_t iters = Iterations(1);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::Seek", size, 0, iters,
+			[&] { prefill(*buffer, payload, 1); },
+			[&](std::size_t i) {
+				buffer->Seek(static_cast<std::ptrdiff_t>(i % (size + 1)), Position::Absolute);
+				buffer->Seek(-1, Position::Relative);
+			}));
+	}
+
+	template<class Buffer>
+	void bench_clean(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		const std::size_t iters = Iterations(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::Clean", size, size, iters,
+			[&] { prefill(*buffer, payload, iters); },
+			[&](std::size_t) {
+				buffer->Seek(static_cast<std::ptrdiff_t>(size), Position::Relative);
+				buffer->Clean();
+			}));
+	}
+
+	// Steady state: every write is immediately followed by an extract of the same size
+	template<class Buffer>
+	void bench_interleaved(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		const std::size_t iters = Iterations(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::WriteExtract", size, size, iters,
+			[&] {},
+			[&](std::size_t) {
+				buffer->Write(payload);
+				auto data = buffer->Extract(size);
+				DoNotOptimize(data);
+			}));
+	}
+
+	// Bursts: several writes accumulate before a single extract drains them
+	template<class Buffer>
+	void bench_burst(Report& report, const std::string& prefix, std::size_t size) {
+		constexpr std::size_t burst = 8;
+		const auto payload = makePayload(size);
+		const std::size_t iters = std::max<std::size_t>(Iterations(size * burst), 1);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::BurstWriteExtract", size, size * burst, iters,
+			[&] {},
+			[&](std::size_t) {
+				for (std::size_t i = 0; i < burst; ++i) buffer->Write(payload);
+				auto data = buffer->Extract(0);
+				DoNotOptimize(data);
+			}));
+	}
+
+	template<class Buffer>
+	void bench_all(Report& report, const std::string& prefix) {
+		for (std::size_t size : PayloadSizes) {
+			bench_write<Buffer>(report, prefix, size);
+			bench_read<Buffer>(report, prefix, size);
+			bench_extract<Buffer>(report, prefix, size);
+			bench_seek<Buffer>(report, prefix, size);
+			bench_clean<Buffer>(report, prefix, size);
+			bench_interleaved<Buffer>(report, prefix, size);
+			bench_burst<Buffer>(report, prefix, size);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	Report report("FIFOBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		bench_all<FIFO>(report, "FIFO");
+		bench_all<SharedFIFO>(report, "SharedFIFO");
+		bench_all<PooledFIFO>(report, "FIFO<SlabPool>");
+	}
+	return report.Finish();
+}
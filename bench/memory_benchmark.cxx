@@ -0,0 +1,155 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/fifo.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+#include <StormByte/buffer/slab_pool.hxx>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::SharedFIFO;
+using StormByte::Buffer::SlabPool;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	// FIFO whose storage comes from the process wide slab pool
+	struct PooledFIFO final: public FIFO {
+		PooledFIFO() noexcept: FIFO(&SlabPool::Instance()) {}
+	};
+
+	constexpr std::size_t piece = 4 * 1024;					// Write size for growth
+	constexpr std::size_t churn_piece = 64 * 1024;			// Write/extract size for churn and drain
+	constexpr std::size_t churn_cycles = 1024;
+
+	const std::vector<std::size_t> target_sizes {
+		64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024
+	};
+
+	double elapsedNs(Clock::time_point start, Clock::time_point end) {
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	double signedDelta(std::size_t after, std::size_t before) {
+		return static_cast<double>(after) - static_cast<double>(before);
+	}
+
+	// Footprint figures relative to `base` for a buffer holding `size` logical bytes
+	void addFootprint(Result& result, const std::string& prefix, const MemoryUsage& base, const MemoryUsage& now, std::size_t size) {
+		const double heap = signedDelta(now.heap, base.heap);
+		const double rss = signedDelta(now.rss, base.rss);
+		result.metrics.emplace_back(prefix + "size_bytes", static_cast<double>(size));
+		result.metrics.emplace_back(prefix + "heap_bytes", heap);
+		result.metrics.emplace_back(prefix + "rss_bytes", rss);
+		if (size > 0) {
+			// Bytes of overhead per buffered byte: 0 is perfect, 1 means twice Size()
+			result.metrics.emplace_back(prefix + "heap_overhead_per_byte", (heap - static_cast<double>(size)) / static_cast<double>(size));
+			result.metrics.emplace_back(prefix + "rss_overhead_per_byte", (rss - static_cast<double>(size)) / static_cast<double>(size));
+		}
+	}
+
+	// Grow an empty buffer to `target` bytes with small writes
+	template<class Buffer>
+	void bench_growth(Report& report, const std::string& prefix, std::size_t target) {
+		const std::vector<std::byte> payload(piece, std::byte { 'g' });
+		const std::size_t writes = target / piece;
+		TrimHeap();
+		const MemoryUsage base = Memory();
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		auto buffer = std::make_unique<Buffer>();
+		for (std::size_t i = 0; i < writes; ++i) buffer->Write(payload);
+		const auto end = Clock::now();
+		const AllocationStats delta = Allocations() - before;
+
+		Result result = MakeResult(prefix + "::Growth", target, piece, writes, elapsedNs(start, end), delta.allocations);
+		addFootprint(result, "", base, Memory(), buffer->Size());
+		report.Add(std::move(result));
+	}
+
+	// Hold `target` bytes while writing and extracting equal pieces
+	template<class Buffer>
+	void bench_churn(Report& report, const std::string& prefix, std::size_t target) {
+		const std::vector<std::byte> payload(churn_piece, std::byte { 'c' });
+		TrimHeap();
+		const MemoryUsage base = Memory();
+		auto buffer = std::make_unique<Buffer>();
+		for (std::size_t filled = 0; filled < target; filled += churn_piece) buffer->Write(payload);
+		const MemoryUsage filled = Memory();
+
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		for (std::size_t i = 0; i < churn_cycles; ++i) {
+			buffer->Write(payload);
+			auto out = buffer->Extract(churn_piece);
+			DoNotOptimize(out);
+		}
+		const auto end = Clock::now();
+		const AllocationStats delta = Allocations() - before;
+
+		Result result = MakeResult(prefix + "::Churn", target, churn_piece, churn_cycles, elapsedNs(start, end), delta.allocations);
+		const MemoryUsage after = Memory();
+		addFootprint(result, "", base, after, buffer->Size());
+		// Growth caused by churn alone, on top of the filled footprint
+		result.metrics.emplace_back("churn_heap_growth_bytes", signedDelta(after.heap, filled.heap));
+		result.metrics.emplace_back("churn_rss_growth_bytes", signedDelta(after.rss, filled.rss));
+		report.Add(std::move(result));
+	}
+
+	// Fill to `target` bytes, then drain it all and see what the empty buffer keeps
+	template<class Buffer>
+	void bench_burst_drain(Report& report, const std::string& prefix, std::size_t target) {
+		const std::vector<std::byte> payload(churn_piece, std::byte { 'b' });
+		TrimHeap();
+		const MemoryUsage base = Memory();
+		auto buffer = std::make_unique<Buffer>();
+		for (std::size_t filled = 0; filled < target; filled += churn_piece) buffer->Write(payload);
+		const MemoryUsage peak = Memory();
+		const std::size_t peak_size = buffer->Size();
+
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		std::size_t extracts = 0;
+		while (!buffer->Empty()) {
+			auto out = buffer->Extract(churn_piece);
+			DoNotOptimize(out);
+			++extracts;
+		}
+		const auto end = Clock::now();
+		const AllocationStats delta = Allocations() - before;
+
+		Result result = MakeResult(prefix + "::BurstDrain", target, churn_piece, extracts, elapsedNs(start, end), delta.allocations);
+		addFootprint(result, "peak_", base, peak, peak_size);
+		const MemoryUsage drained = Memory();
+		// An empty buffer ideally keeps nothing
+		result.metrics.emplace_back("drained_heap_bytes", signedDelta(drained.heap, base.heap));
+		result.metrics.emplace_back("drained_rss_bytes", signedDelta(drained.rss, base.rss));
+		buffer->Clean();
+		const MemoryUsage cleaned = Memory();
+		result.metrics.emplace_back("cleaned_heap_bytes", signedDelta(cleaned.heap, base.heap));
+		result.metrics.emplace_back("cleaned_rss_bytes", signedDelta(cleaned.rss, base.rss));
+		report.Add(std::move(result));
+	}
+
+	template<class Buffer>
+	void bench_all(Report& report, const std::string& prefix) {
+		for (std::size_t target : target_sizes) {
+			bench_growth<Buffer>(report, prefix, target);
+			bench_churn<Buffer>(report, prefix, target);
+			bench_burst_drain<Buffer>(report, prefix, target);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	Report report("MemoryBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		// One entry per storage backend
+		bench_all<FIFO>(report, "FIFO");
+		bench_all<SharedFIFO>(report, "SharedFIFO");
+		bench_all<PooledFIFO>(report, "FIFO<SlabPool>");
+	}
+	return report.Finish();
+}
@@ -0,0 +1,118 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/fifo.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::Position;
+using StormByte::Buffer::StorageOptions;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	constexpr std::size_t StreamSize = 4 * 1024 * 1024;
+	constexpr std::size_t Reserved = 1024 * 1024;
+	const std::vector<std::size_t> ChunkSizes { 4 * 1024, 64 * 1024 };
+
+	// Length prefixed frames (4 byte length, then 16 B to 2 KiB of payload), ending on a frame boundary
+	std::vector<std::byte> makeStream() {
+		std::mt19937 rng(42);
+		std::uniform_int_distribution<std::uint32_t> length(16, 2048);
+		std::vector<std::byte> stream;
+		stream.reserve(StreamSize + 4 + 2048);
+		while (stream.size() < StreamSize) {
+			const std::uint32_t size = length(rng);
+			const std::size_t at = stream.size();
+			stream.resize(at + 4 + size, static_cast<std::byte>(size));
+			std::memcpy(stream.data() + at, &size, sizeof(size));
+		}
+		return stream;
+	}
+
+	// Parses every complete frame in @p data, returns the bytes they span
+	std::size_t parseFrames(std::span<const std::byte> data, std::uint64_t& checksum) {
+		std::size_t offset = 0;
+		while (data.size() - offset >= 4) {
+			std::uint32_t size;
+			std::memcpy(&size, data.data() + offset, sizeof(size));
+			if (data.size() - offset - 4 < size) break;
+			checksum += size + std::to_integer<std::uint64_t>(data[offset + 4]);
+			offset += 4 + size;
+		}
+		return offset;
+	}
+
+	// Writes the next chunk of the endlessly repeated stream
+	void writeChunk(FIFO& fifo, const std::vector<std::byte>& stream, std::size_t chunk, std::size_t index) {
+		const std::size_t start = (index * chunk) % stream.size();
+		const std::size_t first = std::min(chunk, stream.size() - start);
+		fifo.Write(std::span<const std::byte>(stream.data() + start, first));
+		if (first < chunk) fifo.Write(std::span<const std::byte>(stream.data(), chunk - first));
+	}
+
+	std::unique_ptr<FIFO> makeFIFO(bool mirrored) {
+		auto fifo = std::make_unique<FIFO>();
+		StorageOptions options;
+		options.mirrored = mirrored;
+		fifo->SetStorage(options);
+		fifo->Reserve(Reserved);
+		return fifo;
+	}
+
+	// Today's path: copy the header out, then extract every frame into its own vector
+	void bench_copy(Report& report, const std::vector<std::byte>& stream, std::size_t chunk) {
+		auto fifo = makeFIFO(false);
+		std::uint64_t checksum = 0;
+		report.Add(Measure("FIFO::ReadExtractParse", chunk, chunk, Iterations(chunk),
+			[&] {},
+			[&](std::size_t i) {
+				writeChunk(*fifo, stream, chunk, i);
+				while (fifo->AvailableBytes() >= 4) {
+					auto header = fifo->Read(4);
+					fifo->Seek(0, Position::Absolute);
+					std::uint32_t size;
+					std::memcpy(&size, header->data(), sizeof(size));
+					if (fifo->Size() < 4 + size) break;
+					auto frame = fifo->Extract(4 + size);
+					checksum += size + std::to_integer<std::uint64_t>((*frame)[4]);
+				}
+				DoNotOptimize(checksum);
+			}));
+	}
+
+	// Parse in place from Peek(), then drop the parsed frames
+	void bench_peek(Report& report, const std::string& prefix, bool mirrored, const std::vector<std::byte>& stream, std::size_t chunk) {
+		auto fifo = makeFIFO(mirrored);
+		std::uint64_t checksum = 0;
+		report.Add(Measure(prefix + "::PeekParse", chunk, chunk, Iterations(chunk),
+			[&] {},
+			[&](std::size_t i) {
+				writeChunk(*fifo, stream, chunk, i);
+				const std::size_t parsed = parseFrames(fifo->Peek(), checksum);
+				fifo->Seek(static_cast<std::ptrdiff_t>(parsed), Position::Absolute);
+				fifo->Clean();
+				DoNotOptimize(checksum);
+			}));
+	}
+}
+
+int main(int argc, char** argv) {
+	Report report("ParseBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+	const auto stream = makeStream();
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		for (std::size_t chunk : ChunkSizes) {
+			bench_copy(report, stream, chunk);
+			bench_peek(report, "FIFO", false, stream, chunk);
+			if constexpr (StorageOptions::MappingSupported)
+				bench_peek(report, "FIFO<mirrored>", true, stream, chunk);
+		}
+	}
+	return report.Finish();
+}
@@ -0,0 +1,149 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/pipeline.hxx>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using StormByte::Buffer::Consumer;
+using StormByte::Buffer::ExecutionMode;
+using StormByte::Buffer::Pipeline;
+using StormByte::Buffer::Producer;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	constexpr std::size_t chunk_size = 16 * 1024;
+	constexpr std::size_t chunk_count = 256;
+	constexpr auto spin_cost = std::chrono::nanoseconds(2000);
+
+	enum class StageCost {
+		Memcpy,		// Copy every chunk into a fresh vector before forwarding it
+		Spin,		// Busy wait a fixed time per chunk
+		Transform	// Touch every byte (XOR) in place
+	};
+
+	const char* toString(StageCost cost) {
+		switch (cost) {
+			case StageCost::Memcpy:		return "memcpy";
+			case StageCost::Spin:		return "spin";
+			default:					return "transform";
+		}
+	}
+
+	double elapsedNs(Clock::time_point start, Clock::time_point end) {
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	// Every stage forwards exactly chunk_size bytes per chunk so chunk boundaries survive
+	// the whole pipeline and per-chunk latency can be computed at the output.
+	StormByte::Buffer::PipeFunction makeStage(StageCost cost, Clock::time_point* started) {
+		return [cost, started](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+			*started = Clock::now();
+			while (true) {
+				auto data = in.Extract(chunk_size);
+				if (!data) break;
+				if (data->empty()) {
+					if (in.EoF()) break;
+					continue;
+				}
+				switch (cost) {
+					case StageCost::Memcpy: {
+						std::vector<std::byte> copy(data->size());
+						std::memcpy(copy.data(), data->data(), data->size());
+						out.Write(copy);
+						break;
+					}
+					case StageCost::Spin: {
+						const auto until = Clock::now() + spin_cost;
+						while (Clock::now() < until) {}
+						out.Write(*data);
+						break;
+					}
+					case StageCost::Transform: {
+						for (auto& b : *data) b ^= std::byte { 0x5A };
+						out.Write(*data);
+						break;
+					}
+				}
+			}
+			out.Close();
+		};
+	}
+
+	Result run(std::size_t stages, StageCost cost, ExecutionMode mode) {
+		std::vector<Clock::time_point> stage_started(stages);
+		Pipeline pipeline;
+		for (std::size_t i = 0; i < stages; ++i)
+			pipeline.AddPipe(makeStage(cost, &stage_started[i]));
+
+		const std::vector<std::byte> chunk(chunk_size, std::byte { 0x11 });
+		std::vector<Clock::time_point> written(chunk_count);
+		std::vector<double> latencies;
+		latencies.reserve(chunk_count);
+
+		Producer input;
+		std::atomic<bool> go { false };
+		std::thread writer([&, in = input]() mutable {
+			while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+			for (std::size_t i = 0; i < chunk_count; ++i) {
+				written[i] = Clock::now();
+				in.Write(chunk);
+			}
+			in.Close();
+		});
+
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		if (mode == ExecutionMode::Sync) go.store(true, std::memory_order_release);
+		Consumer output = pipeline.Process(input.Consumer(), mode, nullptr);
+		const auto processed = Clock::now();
+		if (mode == ExecutionMode::Async) go.store(true, std::memory_order_release);
+
+		Clock::time_point first_byte {};
+		std::size_t received = 0;
+		while (received < chunk_count) {
+			auto data = output.Extract(chunk_size);
+			const auto now = Clock::now();
+			if (!data || data->empty()) {
+				if (output.EoF()) break;
+				continue;
+			}
+			if (received == 0) first_byte = now;
+			latencies.push_back(elapsedNs(written[received], now));
+			++received;
+		}
+		const auto end = Clock::now();
+		writer.join();
+		const AllocationStats delta = Allocations() - before;
+
+		Clock::time_point last_started = start;
+		for (const auto& t : stage_started) last_started = std::max(last_started, t);
+
+		const std::string name = "Pipeline::S" + std::to_string(stages) + "/" + toString(cost)
+			+ (mode == ExecutionMode::Async ? "/async" : "/sync");
+		Result result = MakeResult(name, chunk_size, chunk_size, received, elapsedNs(start, end), delta.allocations);
+		result.metrics.emplace_back("process_ns", elapsedNs(start, processed));
+		result.metrics.emplace_back("stage_startup_ns", elapsedNs(start, last_started));
+		result.metrics.emplace_back("ttfb_ns", received > 0 ? elapsedNs(start, first_byte) : 0);
+		AddPercentiles(result, "latency", ComputePercentiles(latencies));
+		return result;
+	}
+}
+
+int main(int argc, char** argv) {
+	Report report("PipelineBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		for (auto mode : { ExecutionMode::Async, ExecutionMode::Sync }) {
+			for (auto cost : { StageCost::Memcpy, StageCost::Spin, StageCost::Transform }) {
+				for (std::size_t stages : { 1, 2, 4, 8, 16, 32 }) {
+					report.Add(run(stages, cost, mode));
+				}
+			}
+		}
+	}
+	return report.Finish();
+}
@@ -0,0 +1,153 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/consumer.hxx>
+#include <StormByte/buffer/producer.hxx>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using StormByte::Buffer::Consumer;
+using StormByte::Buffer::Producer;
+using StormByte::Buffer::SharedFIFO;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	enum class ConsumerStyle {
+		Blocking,	// Extract(write_size) blocks until a full chunk is there
+		Polling		// Extract(0) takes whatever is there and yields when empty
+	};
+
+	const char* toString(ConsumerStyle style) {
+		return style == ConsumerStyle::Blocking ? "blocking" : "polling";
+	}
+
+	double elapsedNs(Clock::time_point start, Clock::time_point end) {
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	Result run(std::size_t producers, std::size_t consumers, std::size_t write_size, ConsumerStyle style) {
+		constexpr std::size_t budget = 32 * 1024 * 1024;
+		const std::size_t writes_per_producer = std::clamp<std::size_t>(budget / write_size / producers, 16, 100000);
+		const std::size_t total_writes = writes_per_producer * producers;
+		const std::vector<std::byte> payload(write_size, std::byte { 0x5A });
+
+		Producer producer;
+		Consumer consumer = producer.Consumer();
+
+		std::atomic<bool> go { false };
+		std::atomic<std::size_t> consumed { 0 };
+		std::vector<std::vector<double>> write_latencies(producers);
+		std::vector<std::vector<double>> extract_latencies(consumers);
+		for (auto& v : write_latencies) v.reserve(writes_per_producer);
+		for (auto& v : extract_latencies) v.reserve(total_writes);
+
+		std::vector<std::thread> threads;
+		threads.reserve(producers + consumers);
+		for (std::size_t p = 0; p < producers; ++p) {
+			threads.emplace_back([&, p, out = producer]() mutable {
+				while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+				auto& latencies = write_latencies[p];
+				for (std::size_t i = 0; i < writes_per_producer; ++i) {
+					const auto start = Clock::now();
+					out.Write(payload);
+					latencies.push_back(elapsedNs(start, Clock::now()));
+				}
+			});
+		}
+		for (std::size_t c = 0; c < consumers; ++c) {
+			threads.emplace_back([&, c, in = consumer]() mutable {
+				while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+				auto& latencies = extract_latencies[c];
+				const std::size_t request = style == ConsumerStyle::Blocking ? write_size : 0;
+				while (!in.EoF()) {
+					const auto start = Clock::now();
+					auto data = in.Extract(request);
+					const auto end = Clock::now();
+					if (!data) break;
+					if (data->empty()) {
+						if (style == ConsumerStyle::Polling) std::this_thread::yield();
+						continue;
+					}
+					latencies.push_back(elapsedNs(start, end));
+					consumed.fetch_add(data->size(), std::memory_order_relaxed);
+				}
+			});
+		}
+
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		go.store(true, std::memory_order_release);
+		for (std::size_t p = 0; p < producers; ++p) threads[p].join();
+		producer.Close();
+		for (std::size_t c = producers; c < threads.size(); ++c) threads[c].join();
+		const auto end = Clock::now();
+		const AllocationStats delta = Allocations() - before;
+
+		const std::string name = "SharedFIFO::P" + std::to_string(producers) + "xC" + std::to_string(consumers)
+			+ "/" + toString(style);
+		Result result = MakeResult(name, write_size, write_size, total_writes, elapsedNs(start, end), delta.allocations);
+
+		std::vector<double> writes, extracts;
+		for (auto& v : write_latencies) writes.insert(writes.end(), v.begin(), v.end());
+		for (auto& v : extract_latencies) extracts.insert(extracts.end(), v.begin(), v.end());
+		AddPercentiles(result, "write", ComputePercentiles(writes));
+		AddPercentiles(result, "extract", ComputePercentiles(extracts));
+		result.metrics.emplace_back("consumed_bytes", static_cast<double>(consumed.load()));
+		return result;
+	}
+
+	// A reader that stalls for a whole burst, with the burst held in memory or spilled to disk
+	Result run_burst(std::size_t write_size, bool spill) {
+		constexpr std::size_t burst = 64 * 1024 * 1024;
+		const std::size_t writes = burst / write_size;
+		const std::vector<std::byte> payload(write_size, std::byte { 0x5A });
+
+		SharedFIFO fifo;
+		if (spill) fifo.SetSpill({ 8 * 1024 * 1024, 1024 * 1024, {} });
+		const AllocationStats before = Allocations();
+		const auto start = Clock::now();
+		for (std::size_t i = 0; i < writes; ++i) fifo.Write(payload);
+		fifo.Close();
+		const std::size_t peak = fifo.Capacity();
+		const std::size_t spilled = fifo.SpilledBytes();
+		std::size_t consumed = 0;
+		while (!fifo.EoF()) {
+			auto data = fifo.Extract(write_size);
+			if (!data) break;
+			consumed += data->size();
+		}
+		const auto end = Clock::now();
+		const AllocationStats delta = Allocations() - before;
+
+		Result result = MakeResult(std::string("SharedFIFO::Burst/") + (spill ? "spill" : "memory"), write_size, write_size,
+			writes, elapsedNs(start, end), delta.allocations);
+		result.metrics.emplace_back("capacity_bytes", static_cast<double>(peak));
+		result.metrics.emplace_back("spilled_bytes", static_cast<double>(spilled));
+		result.metrics.emplace_back("consumed_bytes", static_cast<double>(consumed));
+		return result;
+	}
+}
+
+int main(int argc, char** argv) {
+	const std::size_t cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	std::vector<std::size_t> thread_counts { 1, 2, 4, 8 };
+	std::erase_if(thread_counts, [&](std::size_t n) { return n > 1 && n > cores; });
+
+	Report report("ProducerConsumerBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		for (std::size_t write_size : { 64, 4 * 1024, 64 * 1024 }) {
+			for (std::size_t producers : thread_counts) {
+				for (std::size_t consumers : thread_counts) {
+					for (auto style : { ConsumerStyle::Blocking, ConsumerStyle::Polling }) {
+						report.Add(run(producers, consumers, write_size, style));
+					}
+				}
+			}
+			for (bool spill : { false, true }) report.Add(run_burst(write_size, spill));
+		}
+	}
+	return report.Finish();
+}
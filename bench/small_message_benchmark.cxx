@@ -0,0 +1,87 @@
+#include "benchmark.hxx"
+
+#include <StormByte/buffer/fifo.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::SharedFIFO;
+using namespace StormByte::Buffer::Bench;
+
+namespace {
+	// Control message sizes, all within the inline capacity
+	constexpr std::size_t MessageSizes[] { 8, 32, 64 };
+
+	std::vector<std::byte> makePayload(std::size_t size) {
+		std::vector<std::byte> data(size);
+		for (std::size_t i = 0; i < size; ++i) data[i] = static_cast<std::byte>('A' + (i % 26));
+		return data;
+	}
+
+	// Long lived buffer, result returned as std::vector
+	template<class Buffer>
+	void bench_extract_vector(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::WriteExtract", size, size, Iterations(size),
+			[&] {},
+			[&](std::size_t) {
+				buffer->Write(payload);
+				auto data = buffer->Extract(size);
+				DoNotOptimize(data);
+			}));
+	}
+
+	// Long lived buffer, result returned as SmallBytes
+	template<class Buffer>
+	void bench_extract_small(Report& report, const std::string& prefix, std::size_t size) {
+		const auto payload = makePayload(size);
+		auto buffer = std::make_unique<Buffer>();
+		report.Add(Measure(prefix + "::WriteExtractSmall", size, size, Iterations(size),
+			[&] {},
+			[&](std::size_t) {
+				buffer->Write(payload);
+				auto data = buffer->ExtractSmall(size);
+				DoNotOptimize(data);
+			}));
+	}
+
+	// One short lived buffer per message, so every write hits fresh storage
+	void bench_fresh(Report& report, std::size_t size) {
+		const auto payload = makePayload(size);
+		report.Add(Measure("FIFO::FreshWriteExtract", size, size, Iterations(size),
+			[&] {},
+			[&](std::size_t) {
+				FIFO buffer;
+				buffer.Write(payload);
+				auto data = buffer.Extract(size);
+				DoNotOptimize(data);
+			}));
+		report.Add(Measure("FIFO::FreshWriteExtractSmall", size, size, Iterations(size),
+			[&] {},
+			[&](std::size_t) {
+				FIFO buffer;
+				buffer.Write(payload);
+				auto data = buffer.ExtractSmall(size);
+				DoNotOptimize(data);
+			}));
+	}
+}
+
+int main(int argc, char** argv) {
+	Report report("SmallMessageBenchmark", ParseOptions(argc, argv));
+	Report::PrintHeader(std::cout);
+	for (std::size_t rep = 0; rep < report.Repetitions(); ++rep) {
+		for (std::size_t size : MessageSizes) {
+			bench_extract_vector<FIFO>(report, "FIFO", size);
+			bench_extract_small<FIFO>(report, "FIFO", size);
+			bench_extract_vector<SharedFIFO>(report, "SharedFIFO", size);
+			bench_extract_small<SharedFIFO>(report, "SharedFIFO", size);
+			bench_fresh(report, size);
+		}
+	}
+	return report.Finish();
+}
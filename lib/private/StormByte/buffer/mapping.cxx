@@ -0,0 +1,170 @@
+#include <StormByte/buffer/mapping.hxx>
+#include <StormByte/buffer/numa.hxx>
+
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace StormByte::Buffer;
+
+namespace {
+#if defined(__linux__)
+	// Anonymous storage, aligned to the huge page size when it spans whole huge pages
+	std::byte* MapAnonymous(std::size_t size, const StorageOptions& options) {
+		if (options.huge_pages == HugePages::Explicit) {
+			void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (data != MAP_FAILED) return static_cast<std::byte*>(data);
+			// Empty pool: fall back to transparent huge pages
+		}
+		const std::size_t huge = Mapping::HugePageSize();
+		const bool align = options.huge_pages != HugePages::None && size >= huge;
+		const std::size_t extra = align ? huge - Mapping::PageSize() : 0;
+		void* region = ::mmap(nullptr, size + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (region == MAP_FAILED) throw std::bad_alloc();
+		std::byte* data = static_cast<std::byte*>(region);
+		if (align) {
+			const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(region);
+			std::byte* aligned = data + ((huge - start % huge) % huge);
+			if (aligned > data) ::munmap(data, static_cast<std::size_t>(aligned - data));
+			const std::byte* end = data + size + extra;
+			if (aligned + size < end) ::munmap(aligned + size, static_cast<std::size_t>(end - (aligned + size)));
+			data = aligned;
+		}
+		if (options.huge_pages != HugePages::None) ::madvise(data, size, MADV_HUGEPAGE);
+		return data;
+	}
+
+	// A memfd mapped twice, back to back; nullptr on failure
+	std::byte* MapFileTwice(unsigned int flags, std::size_t size) noexcept {
+		const int fd = ::memfd_create("stormbyte-buffer", MFD_CLOEXEC | flags);
+		if (fd < 0) return nullptr;
+		// Reserve the whole range first so both views land back to back
+		void* region = ::ftruncate(fd, static_cast<off_t>(size)) == 0
+			? ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) : MAP_FAILED;
+		std::byte* data = static_cast<std::byte*>(region);
+		const bool mapped = region != MAP_FAILED
+			&& ::mmap(data, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+			&& ::mmap(data + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+		// The mappings keep the file alive
+		::close(fd);
+		if (!mapped) {
+			if (region != MAP_FAILED) ::munmap(region, 2 * size);
+			return nullptr;
+		}
+		return data;
+	}
+
+	std::byte* MapMirrored(std::size_t size, const StorageOptions& options) {
+		std::byte* data = nullptr;
+		if (options.huge_pages == HugePages::Explicit) data = MapFileTwice(MFD_HUGETLB, size);
+		// Empty pool: fall back to regular pages, transparent huge ones if shmem allows
+		if (!data) data = MapFileTwice(0, size);
+		if (!data) throw std::bad_alloc();
+		if (options.huge_pages != HugePages::None) ::madvise(data, 2 * size, MADV_HUGEPAGE);
+		return data;
+	}
+#endif
+}
+
+std::size_t Mapping::PageSize() noexcept {
+#if defined(__linux__)
+	static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	return page;
+#else
+	return 4096;
+#endif
+}
+
+std::size_t Mapping::HugePageSize() noexcept {
+	static const std::size_t huge = [] {
+		std::size_t kib = 0;
+		std::ifstream meminfo("/proc/meminfo");
+		for (std::string key; meminfo >> key;) {
+			if (key == "Hugepagesize:") {
+				meminfo >> kib;
+				break;
+			}
+		}
+		return kib > 0 ? kib * 1024 : std::size_t { 2 * 1024 * 1024 };
+	}();
+	return huge;
+}
+
+std::size_t Mapping::RoundUp(std::size_t size, const StorageOptions& options) noexcept {
+	const std::size_t unit = options.huge_pages == HugePages::Explicit ? HugePageSize() : PageSize();
+	return size == 0 ? unit : (size + unit - 1) / unit * unit;
+}
+
+std::byte* Mapping::Map([[maybe_unused]] std::size_t size, [[maybe_unused]] const StorageOptions& options) {
+#if defined(__linux__)
+	std::byte* data = options.mirrored ? MapMirrored(size, options) : MapAnonymous(size, options);
+	// Set before anything touches the pages; the aliased view of a mirror shares the file policy
+	Numa::Bind(data, size, options.numa_node);
+	// Locking also faults the pages in; over RLIMIT_MEMLOCK the storage stays unlocked
+	if (options.lock) ::mlock(data, options.mirrored ? 2 * size : size);
+	return data;
+#else
+	throw std::bad_alloc();
+#endif
+}
+
+void Mapping::Unmap([[maybe_unused]] std::byte* data, [[maybe_unused]] std::size_t size, [[maybe_unused]] bool mirrored) noexcept {
+#if defined(__linux__)
+	::munmap(data, mirrored ? 2 * size : size);
+#endif
+}
+
+void Mapping::Discard([[maybe_unused]] std::byte* data, [[maybe_unused]] std::size_t size, [[maybe_unused]] const StorageOptions& options) noexcept {
+#if defined(__linux__)
+	// Shared file pages survive MADV_DONTNEED, MADV_REMOVE frees them
+	::madvise(data, RoundUp(size, options), options.mirrored ? MADV_REMOVE : MADV_DONTNEED);
+#endif
+}
+
+void Mapping::Prefault(std::byte* data, std::size_t size) noexcept {
+	const std::size_t page = PageSize();
+	volatile std::byte* bytes = data;
+	// Write back what is there, so the page is faulted in writable without changing it
+	for (std::size_t offset = 0; offset < size; offset += page) bytes[offset] = bytes[offset];
+	if (size > 0) bytes[size - 1] = bytes[size - 1];
+}
+
+std::byte* Mapping::MapFile([[maybe_unused]] int fd, [[maybe_unused]] std::size_t size) noexcept {
+#if defined(__linux__)
+	void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	if (data == MAP_FAILED) return nullptr;
+	::madvise(data, size, MADV_SEQUENTIAL);
+	return static_cast<std::byte*>(data);
+#else
+	return nullptr;
+#endif
+}
+
+namespace {
+	// Start of the page holding data
+	std::byte* PageStart(std::byte* data) noexcept {
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(data);
+		return data - address % Mapping::PageSize();
+	}
+}
+
+void Mapping::ReadAhead([[maybe_unused]] std::byte* data, [[maybe_unused]] std::size_t size) noexcept {
+#if defined(__linux__)
+	std::byte* start = PageStart(data);
+	::madvise(start, size + static_cast<std::size_t>(data - start), MADV_WILLNEED);
+#endif
+}
+
+void Mapping::Drop([[maybe_unused]] std::byte* data, [[maybe_unused]] std::size_t size) noexcept {
+#if defined(__linux__)
+	std::byte* start = PageStart(data);
+	std::byte* end = PageStart(data + size);
+	if (end > start) ::madvise(start, static_cast<std::size_t>(end - start), MADV_DONTNEED);
+#endif
+}
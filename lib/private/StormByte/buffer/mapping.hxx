@@ -0,0 +1,81 @@
+#pragma once
+
+#include <StormByte/buffer/storage.hxx>
+
+#include <cstddef>
+
+/**
+ * @file mapping.hxx
+ * @brief Virtual memory helpers behind the FIFO storage options.
+ *
+ * Internal to the library: not exported and not installed.
+ */
+namespace StormByte::Buffer::Mapping {
+	/**
+	 * @brief Whether @p options need storage mapped by Map() rather than a memory resource.
+	 */
+	constexpr bool Required(const StorageOptions& options) noexcept {
+		return options.mirrored || options.huge_pages != HugePages::None || options.lock
+			|| options.numa_node != StorageOptions::AnyNode;
+	}
+
+	/**
+	 * @brief Size of a virtual memory page.
+	 */
+	std::size_t PageSize() noexcept;
+
+	/**
+	 * @brief Default huge page size.
+	 */
+	std::size_t HugePageSize() noexcept;
+
+	/**
+	 * @brief Round @p size up to a whole, non zero, number of the pages @p options map.
+	 */
+	std::size_t RoundUp(std::size_t size, const StorageOptions& options) noexcept;
+
+	/**
+	 * @brief Map @p size bytes of fresh storage as @p options ask.
+	 * @param size Bytes to map, as returned by RoundUp().
+	 * @return Start of the storage; when mirrored, of a 2 * @p size region whose second
+	 *         half aliases the first.
+	 * @throws std::bad_alloc when the mapping cannot be created or the platform lacks support.
+	 */
+	std::byte* Map(std::size_t size, const StorageOptions& options);
+
+	/**
+	 * @brief Release storage created by Map().
+	 */
+	void Unmap(std::byte* data, std::size_t size, bool mirrored) noexcept;
+
+	/**
+	 * @brief Free the memory behind the first @p size bytes of storage created by Map().
+	 * @details The mapping stays valid; released pages read back as zeros.
+	 */
+	void Discard(std::byte* data, std::size_t size, const StorageOptions& options) noexcept;
+
+	/**
+	 * @brief Touch every page of [data, data + size), keeping its content.
+	 */
+	void Prefault(std::byte* data, std::size_t size) noexcept;
+
+	/**
+	 * @brief Map the first @p size bytes of the file @p fd read-only, to be read front to back.
+	 * @return Start of the mapping, released with Unmap(), or nullptr with @c errno set.
+	 * @details Asks for sequential access, so the kernel reads ahead further and frees
+	 *          the pages behind sooner.
+	 */
+	std::byte* MapFile(int fd, std::size_t size) noexcept;
+
+	/**
+	 * @brief Start reading [data, data + size) of a mapping created by MapFile() from its file.
+	 */
+	void ReadAhead(std::byte* data, std::size_t size) noexcept;
+
+	/**
+	 * @brief Unmap from this process the pages of a mapping created by MapFile() holding
+	 *        [data, data + size), except the page holding data + size.
+	 * @details They stay in the page cache and read back from the file if touched again.
+	 */
+	void Drop(std::byte* data, std::size_t size) noexcept;
+}
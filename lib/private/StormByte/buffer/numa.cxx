@@ -0,0 +1,107 @@
+#include <StormByte/buffer/numa.hxx>
+#include <StormByte/buffer/storage.hxx>
+
+#include <array>
+#include <climits>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace StormByte::Buffer;
+
+namespace {
+	constexpr int MaxNodes = 1024;												///< Nodes a Bind() mask can hold
+	constexpr std::size_t LongBits = sizeof(unsigned long) * CHAR_BIT;
+
+	// Call f for every number of a sysfs list such as "0-3,8,10-11"; false if the file is missing
+	template<class Function>
+	bool ForEachInList(const std::string& path, Function f) {
+		std::ifstream file(path);
+		std::string list;
+		if (!(file >> list)) return false;
+		std::size_t position = 0;
+		while (position < list.size()) {
+			std::size_t end = list.find(',', position);
+			if (end == std::string::npos) end = list.size();
+			const std::string range = list.substr(position, end - position);
+			const std::size_t dash = range.find('-');
+			try {
+				const int first = std::stoi(range.substr(0, dash));
+				const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+				for (int value = first; value <= last; ++value) f(value);
+			} catch (...) {
+				return false;
+			}
+			position = end + 1;
+		}
+		return true;
+	}
+
+	std::string NodePath(int node) {
+		return "/sys/devices/system/node/node" + std::to_string(node);
+	}
+}
+
+bool Numa::Available([[maybe_unused]] int node) noexcept {
+#if defined(__linux__)
+	if (node < 0 || node >= MaxNodes) return false;
+	try {
+		bool found = false;
+		ForEachInList("/sys/devices/system/node/has_memory", [&](int value) { found = found || value == node; });
+		return found;
+	} catch (...) {
+		return false;
+	}
+#else
+	return false;
+#endif
+}
+
+int Numa::CurrentNode() noexcept {
+#if defined(__linux__)
+	unsigned int cpu = 0, node = 0;
+	if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif
+	return -1;
+}
+
+void Numa::Bind([[maybe_unused]] std::byte* data, [[maybe_unused]] std::size_t size, [[maybe_unused]] int node) noexcept {
+#if defined(__linux__)
+	if (node == StorageOptions::LocalNode) {
+		::syscall(SYS_mbind, data, size, MPOL_LOCAL, nullptr, 0UL, 0U);
+	} else if (node >= 0 && node < MaxNodes) {
+		// Preferred rather than bound: a full node spills over instead of failing the fault
+		std::array<unsigned long, MaxNodes / LongBits> mask {};
+		mask[static_cast<std::size_t>(node) / LongBits] = 1UL << (static_cast<std::size_t>(node) % LongBits);
+		::syscall(SYS_mbind, data, size, MPOL_PREFERRED, mask.data(), static_cast<unsigned long>(MaxNodes) + 1, 0U);
+	}
+#endif
+}
+
+bool Numa::RunOn([[maybe_unused]] int node) noexcept {
+#if defined(__linux__)
+	if (node < 0 || node >= MaxNodes) return false;
+	try {
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		bool any = false;
+		const bool listed = ForEachInList(NodePath(node) + "/cpulist", [&](int cpu) {
+			if (cpu >= 0 && cpu < CPU_SETSIZE) {
+				CPU_SET(cpu, &cpus);
+				any = true;
+			}
+		});
+		return listed && any && ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+	} catch (...) {
+		return false;
+	}
+#else
+	return false;
+#endif
+}
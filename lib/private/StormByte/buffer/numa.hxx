@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file numa.hxx
+ * @brief NUMA placement helpers behind StorageOptions::numa_node and Pipeline::SetStageNode().
+ *
+ * Internal to the library: not exported and not installed. Uses the @c mbind and
+ * @c sched_setaffinity system calls directly, so it needs neither libnuma nor its headers.
+ */
+namespace StormByte::Buffer::Numa {
+	/**
+	 * @brief Whether NUMA node @p node exists and has memory.
+	 * @return false on platforms without NUMA support.
+	 */
+	bool Available(int node) noexcept;
+
+	/**
+	 * @brief Node of the CPU the calling thread runs on; -1 when unknown.
+	 */
+	int CurrentNode() noexcept;
+
+	/**
+	 * @brief Set the memory policy of [data, data + size) before it is touched.
+	 * @param node A node for which Available() holds: pages are preferred there.
+	 *             StorageOptions::LocalNode: pages go to the node of the thread that first
+	 *             touches them. Anything else leaves the policy alone.
+	 * @details Best effort: a failing call leaves the default policy in place.
+	 */
+	void Bind(std::byte* data, std::size_t size, int node) noexcept;
+
+	/**
+	 * @brief Restrict the calling thread to the CPUs of @p node.
+	 * @return Whether the affinity was changed.
+	 */
+	bool RunOn(int node) noexcept;
+}
@@ -0,0 +1,90 @@
+#include <StormByte/buffer/spill_file.hxx>
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+using namespace StormByte::Buffer;
+
+bool SpillFile::Supported() noexcept {
+#if defined(__linux__)
+	return true;
+#else
+	return false;
+#endif
+}
+
+int SpillFile::Open([[maybe_unused]] const std::filesystem::path& directory) noexcept {
+#if defined(__linux__)
+	try {
+		std::error_code error;
+		const std::filesystem::path parent = directory.empty() ? std::filesystem::temp_directory_path(error) : directory;
+		if (error) return -1;
+		// Never linked into the directory: nothing is left behind if the process dies
+		int fd = ::open(parent.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+		if (fd >= 0) return fd;
+		// File systems without O_TMPFILE: unlink a named file right away
+		std::string name = (parent / "stormbyte-spill-XXXXXX").string();
+		fd = ::mkostemp(name.data(), O_CLOEXEC);
+		if (fd >= 0) ::unlink(name.c_str());
+		return fd;
+	} catch (...) {
+		return -1;
+	}
+#else
+	return -1;
+#endif
+}
+
+bool SpillFile::Write([[maybe_unused]] int fd, std::span<const std::byte> first, std::span<const std::byte> second,
+	[[maybe_unused]] std::uint64_t offset) noexcept {
+#if defined(__linux__)
+	while (!first.empty() || !second.empty()) {
+		iovec vectors[2] = {
+			{ const_cast<std::byte*>(first.data()), first.size() },
+			{ const_cast<std::byte*>(second.data()), second.size() }
+		};
+		const ssize_t result = first.empty()
+			? ::pwritev(fd, vectors + 1, 1, static_cast<off_t>(offset))
+			: ::pwritev(fd, vectors, second.empty() ? 1 : 2, static_cast<off_t>(offset));
+		if (result < 0 && errno == EINTR) continue;
+		if (result <= 0) return false;
+		std::size_t written = static_cast<std::size_t>(result);
+		offset += written;
+		const std::size_t from_first = std::min(written, first.size());
+		first = first.subspan(from_first);
+		second = second.subspan(written - from_first);
+	}
+	return true;
+#else
+	return first.empty() && second.empty();
+#endif
+}
+
+void SpillFile::ReadAhead([[maybe_unused]] int fd, [[maybe_unused]] std::uint64_t offset, [[maybe_unused]] std::size_t size) noexcept {
+#if defined(__linux__)
+	if (size > 0) ::posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#endif
+}
+
+void SpillFile::Reset([[maybe_unused]] int fd) noexcept {
+#if defined(__linux__)
+	if (fd < 0) return;
+	::lseek(fd, 0, SEEK_SET);
+	if (::ftruncate(fd, 0) != 0) {
+		// Best effort: the old content is overwritten from the start
+	}
+#endif
+}
+
+void SpillFile::Close([[maybe_unused]] int fd) noexcept {
+#if defined(__linux__)
+	if (fd >= 0) ::close(fd);
+#endif
+}
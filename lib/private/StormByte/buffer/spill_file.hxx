@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+/**
+ * @file spill_file.hxx
+ * @brief Temporary file helpers behind SpillPolicy.
+ *
+ * Internal to the library: not exported and not installed.
+ */
+namespace StormByte::Buffer::SpillFile {
+	/**
+	 * @brief Whether spilling to disk is supported on this platform.
+	 */
+	bool Supported() noexcept;
+
+	/**
+	 * @brief Create an anonymous file in @p directory, removed once closed.
+	 * @param directory Directory to create it in; empty for the system temporary directory.
+	 * @return The descriptor, or -1 on failure.
+	 */
+	int Open(const std::filesystem::path& directory) noexcept;
+
+	/**
+	 * @brief Write @p first then @p second to @p fd at @p offset, retrying short writes.
+	 * @return false when not every byte could be written (disk full...).
+	 */
+	bool Write(int fd, std::span<const std::byte> first, std::span<const std::byte> second, std::uint64_t offset) noexcept;
+
+	/**
+	 * @brief Ask the kernel to start reading [offset, offset + size) of @p fd.
+	 */
+	void ReadAhead(int fd, std::uint64_t offset, std::size_t size) noexcept;
+
+	/**
+	 * @brief Drop the content of @p fd, giving its blocks back, and rewind it.
+	 */
+	void Reset(int fd) noexcept;
+
+	/**
+	 * @brief Close @p fd when it is open.
+	 */
+	void Close(int fd) noexcept;
+}
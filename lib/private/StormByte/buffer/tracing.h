@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * @file tracing.h
+ * @brief Static (USDT) tracepoints on the buffer hot paths.
+ *
+ * When the library is built with @c ENABLE_USDT and @c sys/sdt.h is available, each
+ * @c STORMBYTE_BUFFER_PROBEn expands to a @c DTRACE_PROBEn marker under the
+ * @c stormbyte_buffer provider. A marker is a single @c nop in the code plus an ELF
+ * note, so unattached probes cost next to nothing. Tools such as @c perf, @c bpftrace
+ * or SystemTap can attach to them at runtime. Otherwise the macros expand to nothing
+ * and their arguments are not evaluated.
+ *
+ * Probes (arguments in order):
+ *  - @c write         (buffer, bytes written, buffer size after the write)
+ *  - @c extract       (buffer, bytes extracted, bytes left)
+ *  - @c wait__begin   (buffer, bytes requested, bytes available)
+ *  - @c wait__end     (buffer, bytes available)
+ *  - @c notify        (buffer, blocked readers)
+ *  - @c close         (buffer)
+ *  - @c error         (buffer)
+ *  - @c stage__start  (pipeline, stage index)
+ *  - @c stage__finish (pipeline, stage index)
+ */
+
+#ifdef STORMBYTE_BUFFER_USDT
+	#include <sys/sdt.h>
+
+	#define STORMBYTE_BUFFER_PROBE1(name, a1)			DTRACE_PROBE1(stormbyte_buffer, name, a1)
+	#define STORMBYTE_BUFFER_PROBE2(name, a1, a2)		DTRACE_PROBE2(stormbyte_buffer, name, a1, a2)
+	#define STORMBYTE_BUFFER_PROBE3(name, a1, a2, a3)	DTRACE_PROBE3(stormbyte_buffer, name, a1, a2, a3)
+#else
+	#define STORMBYTE_BUFFER_PROBE1(name, a1)
+	#define STORMBYTE_BUFFER_PROBE2(name, a1, a2)
+	#define STORMBYTE_BUFFER_PROBE3(name, a1, a2, a3)
+#endif
@@ -0,0 +1,190 @@
+#include <StormByte/buffer/uring.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__) && defined(STORMBYTE_BUFFER_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define STORMBYTE_BUFFER_HAVE_IO_URING
+#endif
+
+using namespace StormByte::Buffer;
+
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+namespace {
+	// Ring indexes are shared with the kernel
+	std::atomic_ref<std::uint32_t> Index(void* rings, std::uint32_t offset) noexcept {
+		return std::atomic_ref<std::uint32_t>(*reinterpret_cast<std::uint32_t*>(static_cast<std::byte*>(rings) + offset));
+	}
+}
+#endif
+
+Uring::~Uring() noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	if (m_entries) ::munmap(m_entries, m_entries_size);
+	if (m_rings) ::munmap(m_rings, m_rings_size);
+	// Closing the ring also releases registered buffers and files
+	if (m_fd >= 0) ::close(m_fd);
+#endif
+}
+
+bool Uring::Available() noexcept {
+	Uring probe;
+	return probe.Open(1);
+}
+
+bool Uring::Open([[maybe_unused]] unsigned entries) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+	if (fd < 0) return false;
+	m_fd = fd;
+	// IORING_OP_READ/WRITE at the file position (5.6) and a single mapping for both rings (5.4)
+	if (!(params.features & IORING_FEAT_RW_CUR_POS) || !(params.features & IORING_FEAT_SINGLE_MMAP)) return false;
+
+	m_rings_size = std::max<std::size_t>(params.sq_off.array + params.sq_entries * sizeof(std::uint32_t),
+		params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+	void* rings = ::mmap(nullptr, m_rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (rings == MAP_FAILED) return false;
+	m_rings = rings;
+	m_entries_size = params.sq_entries * sizeof(io_uring_sqe);
+	void* sqes = ::mmap(nullptr, m_entries_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED) return false;
+	m_entries = sqes;
+
+	m_sq_head = params.sq_off.head;
+	m_sq_tail = params.sq_off.tail;
+	m_sq_mask = *reinterpret_cast<std::uint32_t*>(static_cast<std::byte*>(m_rings) + params.sq_off.ring_mask);
+	m_sq_array = params.sq_off.array;
+	m_sq_size = params.sq_entries;
+	m_cq_head = params.cq_off.head;
+	m_cq_tail = params.cq_off.tail;
+	m_cq_mask = *reinterpret_cast<std::uint32_t*>(static_cast<std::byte*>(m_rings) + params.cq_off.ring_mask);
+	m_cq_entries = params.cq_off.cqes;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Uring::RegisterBuffers([[maybe_unused]] std::span<const std::span<std::byte>> buffers) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	try {
+		std::vector<iovec> vectors;
+		vectors.reserve(buffers.size());
+		for (const auto& buffer : buffers) vectors.push_back({ buffer.data(), buffer.size() });
+		m_buffers = ::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, vectors.data(), static_cast<unsigned>(vectors.size())) == 0;
+	} catch (...) {
+		m_buffers = false;
+	}
+#endif
+}
+
+void Uring::RegisterFile([[maybe_unused]] int fd) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_FILES, &fd, 1U) == 0) m_file = fd;
+#endif
+}
+
+void Uring::UnregisterFile() noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	if (m_file >= 0) ::syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_FILES, nullptr, 0U);
+#endif
+	m_file = -1;
+}
+
+bool Uring::Read(int fd, std::span<std::byte> data, unsigned buffer, std::uint64_t offset, std::uint64_t tag) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	return Queue(m_buffers ? IORING_OP_READ_FIXED : IORING_OP_READ, fd, data.data(), data.size(), buffer, offset, tag);
+#else
+	(void)fd, (void)data, (void)buffer, (void)offset, (void)tag;
+	return false;
+#endif
+}
+
+bool Uring::Write(int fd, std::span<const std::byte> data, unsigned buffer, std::uint64_t offset, std::uint64_t tag) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	return Queue(m_buffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE, fd, data.data(), data.size(), buffer, offset, tag);
+#else
+	(void)fd, (void)data, (void)buffer, (void)offset, (void)tag;
+	return false;
+#endif
+}
+
+bool Uring::Cancel([[maybe_unused]] std::uint64_t target, [[maybe_unused]] std::uint64_t tag) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	// The request to cancel is named by its tag, passed as the address
+	return Queue(IORING_OP_ASYNC_CANCEL, -1, reinterpret_cast<const std::byte*>(target), 0, 0, 0, tag);
+#else
+	return false;
+#endif
+}
+
+bool Uring::Queue([[maybe_unused]] std::uint8_t opcode, [[maybe_unused]] int fd, [[maybe_unused]] const std::byte* data,
+	[[maybe_unused]] std::size_t size, [[maybe_unused]] unsigned buffer, [[maybe_unused]] std::uint64_t offset,
+	[[maybe_unused]] std::uint64_t tag) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	// Only this thread moves the tail; the kernel moves the head
+	const std::uint32_t tail = Index(m_rings, m_sq_tail).load(std::memory_order_relaxed);
+	auto full = [&] { return tail - Index(m_rings, m_sq_head).load(std::memory_order_acquire) >= m_sq_size; };
+	// Never overwrite an entry the kernel has not taken yet
+	if (full() && (!Submit() || full())) return false;
+	const std::uint32_t slot = tail & m_sq_mask;
+	io_uring_sqe& entry = static_cast<io_uring_sqe*>(m_entries)[slot];
+	std::memset(&entry, 0, sizeof(entry));
+	entry.opcode = opcode;
+	if (fd >= 0 && fd == m_file) {
+		entry.fd = 0;
+		entry.flags = IOSQE_FIXED_FILE;
+	} else {
+		entry.fd = fd;
+	}
+	entry.off = offset;
+	entry.addr = reinterpret_cast<std::uint64_t>(data);
+	entry.len = static_cast<std::uint32_t>(size);
+	entry.buf_index = static_cast<std::uint16_t>(buffer);
+	entry.user_data = tag;
+	reinterpret_cast<std::uint32_t*>(static_cast<std::byte*>(m_rings) + m_sq_array)[slot] = slot;
+	Index(m_rings, m_sq_tail).store(tail + 1, std::memory_order_release);
+	++m_queued;
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool Uring::Submit([[maybe_unused]] unsigned wait) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	if (m_queued == 0 && wait == 0) return true;
+	long result;
+	do {
+		result = ::syscall(__NR_io_uring_enter, m_fd, m_queued, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0U, nullptr, 0UL);
+	} while (result < 0 && errno == EINTR);
+	if (result < 0) return false;
+	m_queued -= static_cast<unsigned>(result);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool Uring::Next([[maybe_unused]] Completion& completion) noexcept {
+#if defined(STORMBYTE_BUFFER_HAVE_IO_URING)
+	const std::uint32_t head = Index(m_rings, m_cq_head).load(std::memory_order_relaxed);
+	if (head == Index(m_rings, m_cq_tail).load(std::memory_order_acquire)) return false;
+	const io_uring_cqe& entry = reinterpret_cast<const io_uring_cqe*>(static_cast<std::byte*>(m_rings) + m_cq_entries)[head & m_cq_mask];
+	completion = { entry.user_data, entry.res };
+	Index(m_rings, m_cq_head).store(head + 1, std::memory_order_release);
+	return true;
+#else
+	return false;
+#endif
+}
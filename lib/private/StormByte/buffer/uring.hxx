@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @file uring.hxx
+ * @brief Minimal io_uring submission and completion ring behind UringSource() and UringSink().
+ *
+ * Internal to the library: not exported and not installed. Uses the @c io_uring_setup,
+ * @c io_uring_enter and @c io_uring_register system calls and the kernel header directly,
+ * so it needs neither liburing nor its headers. Without io_uring support at build time
+ * (ENABLE_IO_URING) or at run time every call fails and the stages fall back to
+ * blocking transfers.
+ */
+namespace StormByte::Buffer {
+	class Uring final {
+		public:
+			/**
+			 * @brief A finished request.
+			 */
+			struct Completion {
+				std::uint64_t tag;							///< Tag given to Read() or Write()
+				int result;									///< Bytes transferred, or a negated errno
+			};
+
+			static constexpr std::uint64_t CurrentPosition = ~std::uint64_t { 0 };	///< Offset using and advancing the file position
+
+			Uring() noexcept								= default;
+			Uring(const Uring&)								= delete;
+			Uring& operator=(const Uring&)					= delete;
+			~Uring() noexcept;
+
+			/**
+			 * @brief Whether the library was built with io_uring and the kernel accepts a ring.
+			 */
+			static bool Available() noexcept;
+
+			/**
+			 * @brief Create the ring.
+			 * @param entries Most requests in flight.
+			 * @return false when io_uring is unavailable or lacks reads and writes at the
+			 *         file position (kernels before 5.6).
+			 */
+			bool Open(unsigned entries) noexcept;
+
+			/**
+			 * @brief Register @p buffers so requests on them skip pinning pages every time.
+			 * @details Best effort: on failure (locked memory limit...) requests use plain addresses.
+			 */
+			void RegisterBuffers(std::span<const std::span<std::byte>> buffers) noexcept;
+
+			/**
+			 * @brief Register @p fd so requests on it skip the file table lookup.
+			 * @details Best effort: on failure requests use the descriptor itself.
+			 */
+			void RegisterFile(int fd) noexcept;
+
+			/**
+			 * @brief Drop the descriptor registered by RegisterFile().
+			 * @details The ring holds a reference to a registered file: a pipe or socket
+			 *          closed by its owner only reports end of file once it is dropped.
+			 */
+			void UnregisterFile() noexcept;
+
+			/**
+			 * @brief Queue a read of @p data from @p fd at @p offset.
+			 * @param buffer Index of the registered buffer holding @p data.
+			 * @return false when the submission ring stays full, even after submitting.
+			 */
+			bool Read(int fd, std::span<std::byte> data, unsigned buffer, std::uint64_t offset, std::uint64_t tag) noexcept;
+
+			/**
+			 * @brief Queue a write of @p data to @p fd at @p offset.
+			 * @param buffer Index of the registered buffer holding @p data.
+			 * @return false when the submission ring stays full, even after submitting.
+			 */
+			bool Write(int fd, std::span<const std::byte> data, unsigned buffer, std::uint64_t offset, std::uint64_t tag) noexcept;
+
+			/**
+			 * @brief Queue the cancellation of the request tagged @p target.
+			 * @param tag Tag of the cancellation's own completion.
+			 * @return false when the submission ring stays full, even after submitting.
+			 * @details Both the cancellation and the request complete: the request with
+			 *          @c -ECANCELED unless it had already finished or could not be stopped.
+			 */
+			bool Cancel(std::uint64_t target, std::uint64_t tag) noexcept;
+
+			/**
+			 * @brief Hand queued requests to the kernel and wait for @p wait completions.
+			 * @return false when the kernel refused the call.
+			 */
+			bool Submit(unsigned wait = 0) noexcept;
+
+			/**
+			 * @brief Take the next completion, if any.
+			 */
+			bool Next(Completion& completion) noexcept;
+
+		private:
+			int m_fd = -1;									///< Ring descriptor
+			void* m_rings = nullptr;						///< Submission and completion rings
+			std::size_t m_rings_size = 0;					///< Size of m_rings
+			void* m_entries = nullptr;						///< Submission queue entries
+			std::size_t m_entries_size = 0;					///< Size of m_entries
+			unsigned m_queued = 0;							///< Entries queued since the last Submit()
+			bool m_buffers = false;							///< Whether buffers are registered
+			int m_file = -1;								///< Registered descriptor, at index 0
+			std::uint32_t m_sq_size = 0;					///< Submission queue entries granted by the kernel
+
+			// Offsets into m_rings, from io_uring_params
+			std::uint32_t m_sq_head = 0, m_sq_tail = 0, m_sq_mask = 0, m_sq_array = 0;
+			std::uint32_t m_cq_head = 0, m_cq_tail = 0, m_cq_mask = 0, m_cq_entries = 0;
+
+			/**
+			 * @brief Fill the next submission entry.
+			 * @details A full ring is first submitted, which frees the entries the kernel takes.
+			 * @return false when no entry is free.
+			 */
+			bool Queue(std::uint8_t opcode, int fd, const std::byte* data, std::size_t size, unsigned buffer, std::uint64_t offset, std::uint64_t tag) noexcept;
+	};
+}
@@ -0,0 +1,25 @@
+#include <StormByte/buffer/arena.hxx>
+
+using namespace StormByte::Buffer;
+
+Arena::Arena(std::size_t initial_size, std::pmr::memory_resource* upstream): m_monotonic(initial_size, upstream) {}
+
+std::size_t Arena::Allocated() const noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return m_allocated;
+}
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	void* p = m_monotonic.allocate(bytes, alignment);
+	m_allocated += bytes;
+	return p;
+}
+
+void Arena::do_deallocate(void*, std::size_t, std::size_t) {
+	// Released in bulk on destruction
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
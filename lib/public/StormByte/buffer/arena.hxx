@@ -0,0 +1,56 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @class Arena
+	 * @brief Thread-safe monotonic memory resource released in bulk.
+	 *
+	 * @details Allocations are bump-pointer carves from growing chunks obtained from the
+	 *          upstream resource. Deallocation is a no-op and all memory is returned when
+	 *          the arena is destroyed, so memory use grows with everything allocated during
+	 *          the arena's life: it suits bounded, request sized work. A mutex makes it usable
+	 *          from several threads (e.g. concurrent Pipeline stages).
+	 * @see Pipeline::SetArenaSize()
+	 */
+	class STORMBYTE_BUFFER_PUBLIC Arena final: public std::pmr::memory_resource {
+		public:
+			/**
+			 * @brief Construct an arena.
+			 * @param initial_size Size of the first chunk requested from @p upstream.
+			 * @param upstream Resource the chunks are obtained from.
+			 */
+			explicit Arena(std::size_t initial_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+			Arena(const Arena&) = delete;
+			Arena& operator=(const Arena&) = delete;
+			~Arena() override = default;
+
+			/**
+			 * @brief Total bytes handed out so far.
+			 */
+			std::size_t 											Allocated() const noexcept;
+
+		private:
+			mutable std::mutex m_mutex;								///< Serializes access to m_monotonic
+			std::pmr::monotonic_buffer_resource m_monotonic;		///< Underlying bump allocator
+			std::size_t m_allocated = 0;							///< Bytes handed out
+
+			void* 													do_allocate(std::size_t bytes, std::size_t alignment) override;
+			void 													do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+			bool 													do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	};
+}
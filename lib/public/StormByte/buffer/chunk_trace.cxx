@@ -0,0 +1,76 @@
+#include <StormByte/buffer/chunk_trace.hxx>
+
+#include <atomic>
+
+using namespace StormByte::Buffer;
+
+const std::vector<ChunkTrace>& ChunkTracing::LastExtracted() noexcept {
+	return Context();
+}
+
+void ChunkTracing::Clear() noexcept {
+	Context().clear();
+}
+
+std::vector<ChunkTrace>& ChunkTracing::Context() noexcept {
+	thread_local std::vector<ChunkTrace> context;
+	return context;
+}
+
+std::uint64_t ChunkTracing::NextSequence() noexcept {
+	static std::atomic<std::uint64_t> sequence { 0 };
+	return sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+#ifdef STORMBYTE_BUFFER_CHUNK_TRACING
+void ChunkTraceQueue::OnWrite(std::size_t bytes) {
+	if (bytes == 0) return;
+	auto& context = ChunkTracing::Context();
+	m_tail += bytes;
+	if (context.size() == 1) {
+		// Forwarded data keeps the identity of the one chunk it came from
+		const ChunkTrace& trace = context.front();
+		if (m_first < m_segments.size() && m_segments.back().trace.sequence == trace.sequence)
+			m_segments.back().end = m_tail;
+		else
+			m_segments.push_back({ m_tail, trace });
+	}
+	else {
+		// Fresh data, or several chunks merged: a new chunk rather than one identity for all
+		m_segments.push_back({ m_tail, { ChunkTracing::NextSequence(), std::chrono::steady_clock::now() } });
+	}
+	// Handed off: later writes from this thread, to this or another buffer, start new chunks
+	context.clear();
+}
+
+void ChunkTraceQueue::OnRemove(std::size_t bytes, bool extract) {
+	if (bytes == 0) return;
+	m_head += bytes;
+	if (extract) {
+		auto& context = ChunkTracing::Context();
+		context.clear();
+		// Segments starting before the new head were (at least partly) extracted
+		std::uint64_t start = m_head - bytes;
+		for (std::size_t i = m_first; i < m_segments.size() && start < m_head; ++i) {
+			context.push_back(m_segments[i].trace);
+			start = m_segments[i].end;
+		}
+	}
+	while (m_first < m_segments.size() && m_segments[m_first].end <= m_head)
+		++m_first;
+	if (m_first == m_segments.size()) {
+		m_segments.clear();
+		m_first = 0;
+	}
+	else if (m_first >= 32 && m_first * 2 >= m_segments.size()) {
+		m_segments.erase(m_segments.begin(), m_segments.begin() + static_cast<std::ptrdiff_t>(m_first));
+		m_first = 0;
+	}
+}
+
+void ChunkTraceQueue::OnClear() noexcept {
+	m_segments.clear();
+	m_first = 0;
+	m_head = m_tail;
+}
+#endif
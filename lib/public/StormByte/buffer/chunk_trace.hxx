@@ -0,0 +1,144 @@
+#pragma once
+
+#include <StormByte/buffer/config.h>
+#include <StormByte/buffer/visibility.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @struct ChunkTrace
+	 * @brief Identity and ingest time of a written chunk.
+	 *
+	 * @details Only maintained when the library is built with @c ENABLE_CHUNK_TRACING
+	 *          (which defines @c STORMBYTE_BUFFER_CHUNK_TRACING); @ref Enabled tells which.
+	 * @see ChunkTracing
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC ChunkTrace {
+		#ifdef STORMBYTE_BUFFER_CHUNK_TRACING
+		static constexpr bool Enabled = true;						///< Whether tracing is compiled in
+		#else
+		static constexpr bool Enabled = false;						///< Whether tracing is compiled in
+		#endif
+
+		std::uint64_t sequence = 0;									///< Process wide chunk id, starting at 1
+		std::chrono::steady_clock::time_point ingest {};			///< When the chunk first entered a buffer
+
+		/**
+		 * @brief Time elapsed since the chunk was ingested.
+		 */
+		inline std::chrono::nanoseconds Latency() const noexcept {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ingest);
+		}
+	};
+
+	/**
+	 * @class ChunkTracing
+	 * @brief Per thread propagation context for @ref ChunkTrace.
+	 *
+	 * @par Propagation
+	 *  Every Extract() stores the traces of the chunks it removed in the calling
+	 *  thread's context. When they are a single chunk, the next Write() from the same
+	 *  thread tags its bytes with it instead of starting a new chunk, so a stage that
+	 *  forwards what it extracted keeps the original sequence id and ingest time. A
+	 *  Write() after an Extract() spanning several chunks, or with an empty context,
+	 *  starts a new chunk stamped with the current time. Each Write() consumes the
+	 *  context, so only the first write after an extract inherits and nothing leaks
+	 *  into unrelated buffers written later. Pipeline clears the context before
+	 *  running each stage.
+	 *
+	 * @par Reporting
+	 *  After extracting from the final Consumer, @ref LastExtracted() returns the
+	 *  chunks that were part of the data; @ref ChunkTrace::Latency() gives each one's
+	 *  end-to-end latency.
+	 */
+	class STORMBYTE_BUFFER_PUBLIC ChunkTracing final {
+		public:
+			ChunkTracing() = delete;
+
+			/**
+			 * @brief Chunks touched by the calling thread's last non-empty Extract().
+			 * @return Traces ordered oldest first; empty when tracing is disabled or once a
+			 *         Write() from the thread consumed them.
+			 */
+			static const std::vector<ChunkTrace>& 					LastExtracted() noexcept;
+
+			/**
+			 * @brief Forget the calling thread's context so its next Write() starts a new chunk.
+			 */
+			static void 											Clear() noexcept;
+
+		private:
+			friend class ChunkTraceQueue;
+
+			static std::vector<ChunkTrace>& 						Context() noexcept;
+			static std::uint64_t 									NextSequence() noexcept;
+	};
+
+	/**
+	 * @class ChunkTraceQueue
+	 * @brief Internal per buffer list of the chunks its bytes belong to.
+	 *
+	 * @details Stores one segment per run of bytes written with the same trace, keyed by
+	 *          absolute end offset. Consumed segments are dropped by advancing an index and
+	 *          compacted lazily, so a steady write/extract flow does not allocate. When chunk tracing is disabled this is an empty class
+	 *          whose members are empty inline functions, so buffers store it with
+	 *          @c [[no_unique_address]] and every call compiles away. Not thread-safe:
+	 *          thread-safe buffers update it while holding their own lock.
+	 */
+	class STORMBYTE_BUFFER_PUBLIC ChunkTraceQueue {
+		public:
+			#ifdef STORMBYTE_BUFFER_CHUNK_TRACING
+			/**
+			 * @brief Construct an empty queue allocating from @p resource.
+			 */
+			explicit ChunkTraceQueue(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept: m_segments(resource) {}
+
+			/**
+			 * @brief Tag @p bytes appended bytes with the thread context's chunk, when it holds
+			 *        exactly one, or a new chunk; then clear the context.
+			 */
+			void OnWrite(std::size_t bytes);
+
+			/**
+			 * @brief Drop @p bytes from the front.
+			 * @param extract Whether the bytes were extracted, which publishes their traces
+			 *        to the calling thread's context.
+			 */
+			void OnRemove(std::size_t bytes, bool extract);
+
+			/**
+			 * @brief Drop every segment.
+			 */
+			void OnClear() noexcept;
+
+		private:
+			struct Segment {
+				std::uint64_t end;									///< Absolute offset one past the segment
+				ChunkTrace trace;									///< Chunk the bytes belong to
+			};
+
+			std::pmr::vector<Segment> m_segments;						///< Segments, oldest first from m_first; reused to avoid steady state allocations
+			std::size_t m_first = 0;								///< Index of the oldest live segment
+			std::uint64_t m_head = 0;								///< Absolute offset of the first stored byte
+			std::uint64_t m_tail = 0;								///< Absolute offset one past the last stored byte
+			#else
+			explicit ChunkTraceQueue(std::pmr::memory_resource* = nullptr) noexcept {}
+			inline void OnWrite(std::size_t) noexcept {}
+			inline void OnRemove(std::size_t, bool) noexcept {}
+			inline void OnClear() noexcept {}
+			#endif
+	};
+}
@@ -39,7 +39,8 @@ namespace StormByte::Buffer {
      * @par Producer-Consumer relationship
      *  Consumer instances cannot be created directly. They must be obtained from
      *  a Producer using Producer::Consumer(). This ensures proper buffer sharing
-     *  between producers and consumers.
+     *  between producers and consumers. MapFile() is the exception: its buffer has
+     *  no producer, it holds a whole file from the start.
      *
      * @see Producer
      */
@@ -109,6 +110,12 @@ namespace StormByte::Buffer {
 			 */
 			inline void Clear() noexcept { m_buffer->Clear(); }
 
+			/**
+			 * @brief Remove the bytes before the read position.
+			 * @see SharedFIFO::Clean()
+			 */
+			inline void Clean() noexcept { m_buffer->Clean(); }
+
 			/**
 			 * @brief Non-destructive read from the buffer (blocks until data available).
 			 * @param count Number of bytes to read; 0 reads all available without blocking.
@@ -120,6 +127,12 @@ namespace StormByte::Buffer {
 			 */
 
 			inline ExpectedData<InsufficientData> Read(std::size_t count = 0) { return m_buffer->Read(count); }
+
+			/**
+			 * @brief Read bytes into a vector allocated from @p resource.
+			 * @see Read(std::size_t), SharedFIFO::Read(std::size_t, std::pmr::memory_resource*)
+			 */
+			inline ExpectedPmrData<InsufficientData> Read(std::size_t count, std::pmr::memory_resource* resource) { return m_buffer->Read(count, resource); }
 			
 			/**
 			* @brief Destructive read that removes data from the buffer (blocks until data available).
@@ -131,6 +144,41 @@ namespace StormByte::Buffer {
 			* @see SharedFIFO::Extract(), Read(), IsReadable()
 			*/
 			inline ExpectedData<InsufficientData> Extract(std::size_t count = 0) { return m_buffer->Extract(count); }
+
+			/**
+			 * @brief Extract bytes into a vector allocated from @p resource.
+			 * @see Extract(std::size_t), SharedFIFO::Extract(std::size_t, std::pmr::memory_resource*)
+			 */
+			inline ExpectedPmrData<InsufficientData> Extract(std::size_t count, std::pmr::memory_resource* resource) { return m_buffer->Extract(count, resource); }
+
+			/**
+			 * @brief Extract bytes into a vector with inline capacity; small messages do not allocate.
+			 * @see Extract(std::size_t), SharedFIFO::ExtractSmall()
+			 */
+			inline ExpectedSmallData<InsufficientData> ExtractSmall(std::size_t count = 0) { return m_buffer->ExtractSmall(count); }
+
+			/**
+			 * @brief Contiguous view of buffered bytes from the read position, without copying them.
+			 * @details Follow with Seek() and Clean() to consume what was parsed.
+			 * @warning Same restrictions on the span as SharedFIFO::Peek(). A buffer from
+			 *          MapFile() has no writer, so a single reader may keep it until Clean().
+			 * @see SharedFIFO::Peek(), MapFile()
+			 */
+			inline std::span<const std::byte> Peek(std::size_t count = 0) { return m_buffer->Peek(count); }
+
+			/**
+			 * @brief Write buffered bytes to a file descriptor and remove them, without an intermediate copy.
+			 * @return Bytes written, 0 once the buffer is closed and drained, or IOError.
+			 * @see SharedFIFO::WriteTo(), DescriptorSink()
+			 */
+			inline Expected<std::size_t, IOError> WriteTo(int fd, std::size_t count = 0) { return m_buffer->WriteTo(fd, count); }
+
+			/**
+			 * @brief Move buffered bytes to a file descriptor, and remove them, without copying them to user space (Linux).
+			 * @return Bytes moved, 0 once the buffer is closed and drained, or IOError.
+			 * @see SharedFIFO::SpliceTo(), SpliceSink()
+			 */
+			inline Expected<std::size_t, IOError> SpliceTo(int fd, std::size_t count = 0) { return m_buffer->SpliceTo(fd, count); }
 			
 			/**
 			 * @brief Check if the buffer is readable (not in error state).
@@ -170,6 +218,45 @@ namespace StormByte::Buffer {
 			 */
 			inline bool EoF() const noexcept { return m_buffer->EoF(); }
 
+			/**
+			 * @brief Get the usage counters of the underlying buffer.
+			 * @return Snapshot of the shared buffer statistics (zero unless built with ENABLE_STATS).
+			 * @see SharedFIFO::Stats(), Statistics
+			 */
+			inline Statistics Stats() const noexcept { return m_buffer->Stats(); }
+
+			/**
+			 * @brief Histogram of the time readers of the shared buffer spent blocked.
+			 * @return Live histogram handle, or nullptr when statistics are disabled.
+			 * @see SharedFIFO::WaitHistogram(), LatencyHistogram
+			 */
+			inline std::shared_ptr<const LatencyHistogram> WaitHistogram() const { return m_buffer->WaitHistogram(); }
+
+			/**
+			 * @brief Memory resource the shared buffer's storage is allocated from.
+			 * @details Pipeline stages can pass it to Extract(std::size_t, std::pmr::memory_resource*)
+			 *          to keep their result vectors in the run's arena.
+			 * @see FIFO::MemoryResource(), Pipeline::SetArenaSize()
+			 */
+			inline std::pmr::memory_resource* MemoryResource() const noexcept { return m_buffer->MemoryResource(); }
+
+			/**
+			 * @brief Consumer of a whole file, without reading it first.
+			 * @param path Regular file to read.
+			 * @return A consumer whose buffer is closed and whose storage is the file,
+			 *         mapped read-only, so it is ready at once whatever the file size;
+			 *         IOError when the file cannot be opened or mapped.
+			 * @details Peek() and WriteTo() use the mapping in place. The file is read
+			 *          ahead of the read position and released behind it.
+			 * @warning Same as FIFO::MapFile(): truncating the file while mapped raises SIGBUS.
+			 * @see FIFO::MapFile()
+			 */
+			static Expected<Consumer, IOError> MapFile(const std::filesystem::path& path) {
+				auto buffer = std::make_shared<SharedFIFO>();
+				if (auto mapped = buffer->MapFile(path); !mapped) return StormByte::Unexpected(*mapped.error());
+				return Consumer(std::move(buffer));
+			}
+
         private:
             /** @brief Shared pointer to the underlying thread-safe FIFO buffer. */
             std::shared_ptr<SharedFIFO> m_buffer { std::make_shared<SharedFIFO>() };
@@ -0,0 +1,419 @@
+#include <StormByte/buffer/consumer.hxx>
+#include <StormByte/buffer/descriptor.hxx>
+#include <StormByte/buffer/producer.hxx>
+#include <StormByte/buffer/uring.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace StormByte::Buffer;
+
+namespace {
+	// Source loop shared by the read and splice variants
+	template<class Transfer>
+	PipeFunction Source(Transfer transfer) {
+		return [transfer](Consumer, Producer out, std::shared_ptr<StormByte::Logger>) {
+			while (true) {
+				auto read = transfer(out);
+				if (!read) {
+					out.SetError();
+					return;
+				}
+				if (*read == 0) break;
+			}
+			out.Close();
+		};
+	}
+
+	// Sink loop shared by the write and splice variants
+	template<class Transfer>
+	PipeFunction Sink(Transfer transfer) {
+		return [transfer](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+			while (true) {
+				auto written = transfer(in);
+				if (!written) {
+					out.SetError();
+					return;
+				}
+				if (*written == 0 && in.EoF()) break;
+			}
+			out.Close();
+		};
+	}
+
+	// Blocks a ring reads into and writes out of, registered with the kernel
+	class Staging {
+		public:
+			Staging(std::size_t depth, std::size_t block):
+			m_memory(std::make_unique_for_overwrite<std::byte[]>(depth * block)) {
+				for (std::size_t i = 0; i < depth; ++i) m_blocks.emplace_back(m_memory.get() + i * block, block);
+			}
+
+			std::span<std::byte> operator[](std::size_t index) const noexcept { return m_blocks[index]; }
+			std::size_t Size() const noexcept { return m_blocks.size(); }
+			std::span<const std::span<std::byte>> Blocks() const noexcept { return m_blocks; }
+
+		private:
+			std::unique_ptr<std::byte[]> m_memory;
+			std::vector<std::span<std::byte>> m_blocks;
+	};
+
+	// Hands one staging block to Consumer::Extract(), so extracted bytes land straight in it
+	class BlockResource final: public std::pmr::memory_resource {
+		public:
+			explicit BlockResource(std::span<std::byte> block) noexcept: m_block(block) {}
+
+		private:
+			std::span<std::byte> m_block;
+
+			void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+				if (bytes <= m_block.size()) return m_block.data();
+				return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			}
+			void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+				if (p != m_block.data()) std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+			}
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	// Position of fd when requests on it may run at explicit offsets: regular files and
+	// block devices, not appending when written
+	std::optional<std::uint64_t> FileOffset([[maybe_unused]] int fd, [[maybe_unused]] bool writing) noexcept {
+#if defined(__linux__)
+		struct stat info;
+		if (::fstat(fd, &info) != 0 || !(S_ISREG(info.st_mode) || S_ISBLK(info.st_mode))) return std::nullopt;
+		if (writing && (::fcntl(fd, F_GETFL) & O_APPEND)) return std::nullopt;
+		const off_t position = ::lseek(fd, 0, SEEK_CUR);
+		if (position >= 0) return static_cast<std::uint64_t>(position);
+#endif
+		return std::nullopt;
+	}
+
+	// Tag of cancellations, out of the range of slot indexes
+	constexpr std::uint64_t CancelTag = ~std::uint64_t { 0 };
+
+	// Ring and registered staging a stage keeps across runs, so setting them up is paid once;
+	// the descriptor is registered for each run only
+	class Context {
+		public:
+			Context(int fd, std::size_t depth, std::size_t block) noexcept: m_fd(fd), m_depth(depth), m_block(block) {}
+
+			std::mutex mutex;														// Held by the run using the context
+
+			// Ring ready for a run, or null without io_uring
+			Uring* Ring() {
+				if (!m_ring && !m_unavailable) {
+					m_staging = std::make_unique<Staging>(m_depth, m_block);
+					m_ring = std::make_unique<Uring>();
+					if (m_ring->Open(static_cast<unsigned>(m_depth))) {
+						m_ring->RegisterBuffers(m_staging->Blocks());
+					} else {
+						m_ring.reset();
+						m_unavailable = true;
+					}
+				}
+				if (m_ring) m_ring->RegisterFile(m_fd);
+				return m_ring.get();
+			}
+
+			// End of a run: the ring must not keep the descriptor open past it
+			void Release() noexcept {
+				if (m_ring) m_ring->UnregisterFile();
+			}
+
+			const Staging& Blocks() const noexcept { return *m_staging; }
+
+			// End of a run that left requests behind: cancel them and wait until the kernel is
+			// done with the staging, which the next run or the owner of the context would free.
+			// When that fails the ring and its staging are let go of, never freed, since the
+			// kernel may still write into the blocks; the next run starts over.
+			void Discard(std::size_t in_flight) noexcept {
+				std::size_t waiting = in_flight;
+				bool drained = true;
+				// Tags are slot indexes: cancelling one with no request in flight is harmless
+				for (std::size_t tag = 0; tag < m_depth && drained; ++tag) {
+					drained = m_ring->Cancel(tag, CancelTag);
+					if (drained) ++waiting;
+				}
+				Uring::Completion completion;
+				while (drained && waiting > 0) {
+					drained = m_ring->Submit(1);
+					while (drained && m_ring->Next(completion)) --waiting;
+				}
+				if (!drained) {
+					(void)m_ring.release();
+					(void)m_staging.release();
+				}
+			}
+
+		private:
+			int m_fd;
+			std::size_t m_depth, m_block;
+			std::unique_ptr<Uring> m_ring;
+			std::unique_ptr<Staging> m_staging;
+			bool m_unavailable = false;
+	};
+
+	// Context of a stage for one run; a run overlapping another one of the same stage gets its own
+	class Lease {
+		public:
+			Lease(const std::shared_ptr<Context>& shared, int fd, std::size_t depth, std::size_t block):
+			m_lock(shared->mutex, std::try_to_lock),
+			m_own(m_lock.owns_lock() ? nullptr : std::make_unique<Context>(fd, depth, block)),
+			m_context(m_own ? *m_own : *shared) {}
+			~Lease() noexcept { m_context.Release(); }
+
+			Context* operator->() const noexcept { return &m_context; }
+
+		private:
+			std::unique_lock<std::mutex> m_lock;
+			std::unique_ptr<Context> m_own;
+			Context& m_context;
+	};
+
+	// Limits keeping the ring small and a request length within 32 bits
+	std::size_t Depth(std::size_t depth) noexcept { return std::clamp<std::size_t>(depth, 2, 64); }
+	std::size_t Block(std::size_t block) noexcept { return std::clamp<std::size_t>(block, 1, std::size_t { 1 } << 30); }
+}
+
+PipeFunction StormByte::Buffer::DescriptorSource(int fd, std::size_t count) {
+	return Source([fd, count](Producer& out) { return out.ReadFrom(fd, count); });
+}
+
+PipeFunction StormByte::Buffer::DescriptorSink(int fd) {
+	return Sink([fd](Consumer& in) { return in.WriteTo(fd); });
+}
+
+PipeFunction StormByte::Buffer::SpliceSource(int fd) {
+	return Source([fd](Producer& out) { return out.SpliceFrom(fd); });
+}
+
+PipeFunction StormByte::Buffer::SpliceSink(int fd) {
+	return Sink([fd](Consumer& in) { return in.SpliceTo(fd); });
+}
+
+bool StormByte::Buffer::UringAvailable() noexcept {
+	return Uring::Available();
+}
+
+PipeFunction StormByte::Buffer::UringSource(int fd, std::size_t depth, std::size_t block) {
+	depth = Depth(depth);
+	block = Block(block);
+	auto shared = std::make_shared<Context>(fd, depth, block);
+	return [fd, depth, block, shared, fallback = DescriptorSource(fd, block)](Consumer in, Producer out, std::shared_ptr<StormByte::Logger> logger) {
+		Lease context(shared, fd, depth, block);
+		Uring* const ring = context->Ring();
+		if (!ring) return fallback(in, out, logger);
+		const Staging& staging = context->Blocks();
+
+		struct Slot {
+			std::uint64_t offset = 0;		// File offset of the block
+			std::size_t filled = 0;			// Bytes read into it
+			bool done = false;				// No request in flight
+		};
+		std::vector<Slot> slots(depth);
+		const std::optional<std::uint64_t> start = FileOffset(fd, false);
+		const std::size_t limit = start ? depth : 1;
+		std::uint64_t offset = start.value_or(0), stored = offset;
+		// Slots [first, first + pending) hold requests in flight or blocks not stored yet
+		std::size_t first = 0, pending = 0, in_flight = 0;
+		bool end = false, past_end = false, failed = false;
+
+		auto read = [&](std::size_t index) {
+			// One request per slot and the ring holds at least depth entries: it is never full
+			assert(in_flight < depth);
+			Slot& slot = slots[index];
+			if (!ring->Read(fd, staging[index].subspan(slot.filled), static_cast<unsigned>(index),
+				start ? slot.offset + slot.filled : Uring::CurrentPosition, index)) {
+				failed = slot.done = true;
+				return;
+			}
+			++in_flight;
+		};
+
+		while (true) {
+			while (!end && !failed && pending < depth && in_flight < limit) {
+				const std::size_t index = (first + pending++) % depth;
+				slots[index] = { offset, 0, false };
+				offset += block;
+				read(index);
+			}
+			if (!ring->Submit()) failed = true;
+
+			// Store finished blocks in order while the next reads are in flight
+			while (pending > 0 && slots[first].done) {
+				const Slot& slot = slots[first];
+				if (!failed && !past_end && slot.filled > 0) {
+					if (!out.Write(staging[first].first(slot.filled))) failed = true;
+					stored += slot.filled;
+				}
+				// A short block of a file is its end: later blocks were read past it
+				if (start && slot.filled < block) past_end = true;
+				first = (first + 1) % depth;
+				--pending;
+			}
+			if (pending == 0 && (end || failed)) break;
+			if (in_flight > 0 && !ring->Submit(1)) {
+				failed = true;
+				break;
+			}
+
+			Uring::Completion completion;
+			while (ring->Next(completion)) {
+				--in_flight;
+				const std::size_t index = static_cast<std::size_t>(completion.tag);
+				Slot& slot = slots[index];
+				if (completion.result == -EINTR || completion.result == -EAGAIN) {
+					read(index);
+					continue;
+				}
+				if (completion.result < 0) {
+					failed = true;
+				} else if (completion.result == 0) {
+					end = true;
+				} else {
+					slot.filled += static_cast<std::size_t>(completion.result);
+					// A file may return less than asked before its end: read the rest
+					if (start && slot.filled < block) {
+						read(index);
+						continue;
+					}
+				}
+				slot.done = true;
+			}
+		}
+
+		if (in_flight > 0) context->Discard(in_flight);
+#if defined(__linux__)
+		if (start) ::lseek(fd, static_cast<off_t>(stored), SEEK_SET);
+#endif
+		if (failed) out.SetError();
+		else out.Close();
+	};
+}
+
+PipeFunction StormByte::Buffer::UringSink(int fd, std::size_t depth, std::size_t block) {
+	depth = Depth(depth);
+	block = Block(block);
+	auto shared = std::make_shared<Context>(fd, depth, block);
+	return [fd, depth, block, shared, fallback = DescriptorSink(fd)](Consumer in, Producer out, std::shared_ptr<StormByte::Logger> logger) {
+		Lease context(shared, fd, depth, block);
+		Uring* const ring = context->Ring();
+		if (!ring) return fallback(in, out, logger);
+		const Staging& staging = context->Blocks();
+
+		struct Slot {
+			std::uint64_t offset = 0;		// File offset of the block
+			std::size_t size = 0;			// Bytes taken from the input
+			std::size_t written = 0;		// Bytes written so far
+			bool done = false;				// Fully written
+		};
+		std::vector<Slot> slots(depth);
+		const std::optional<std::uint64_t> start = FileOffset(fd, true);
+		const std::size_t limit = start ? depth : 1;
+		std::uint64_t offset = start.value_or(0);
+		// Slots [first, first + submitted) are being written, the next waiting ones are filled
+		std::size_t first = 0, submitted = 0, waiting = 0, in_flight = 0;
+		bool end = false, failed = false;
+
+		auto write = [&](std::size_t index) {
+			// One request per slot and the ring holds at least depth entries: it is never full
+			assert(in_flight < depth);
+			Slot& slot = slots[index];
+			if (!ring->Write(fd, staging[index].subspan(slot.written, slot.size - slot.written), static_cast<unsigned>(index),
+				start ? slot.offset + slot.written : Uring::CurrentPosition, index)) {
+				failed = slot.done = true;
+				return;
+			}
+			++in_flight;
+		};
+
+		while (true) {
+			Uring::Completion completion;
+			while (ring->Next(completion)) {
+				--in_flight;
+				const std::size_t index = static_cast<std::size_t>(completion.tag);
+				Slot& slot = slots[index];
+				if (completion.result == -EINTR || completion.result == -EAGAIN) {
+					write(index);
+					continue;
+				}
+				if (completion.result <= 0) {
+					failed = true;
+				} else {
+					slot.written += static_cast<std::size_t>(completion.result);
+					if (slot.written < slot.size) {
+						write(index);
+						continue;
+					}
+				}
+				slot.done = true;
+			}
+			while (submitted > 0 && slots[first].done) {
+				first = (first + 1) % depth;
+				--submitted;
+			}
+			if (failed) waiting = 0;
+			while (waiting > 0 && in_flight < limit) {
+				write((first + submitted++) % depth);
+				--waiting;
+			}
+			if (!ring->Submit()) failed = true;
+			if ((end || failed) && submitted == 0 && waiting == 0) break;
+
+			// Take the next block from the input while writes are in flight
+			if (!end && !failed && submitted + waiting < depth) {
+				const std::size_t index = (first + submitted + waiting) % depth;
+				// Wait for one byte (or the end) only when nothing is available, then take what fits
+				std::size_t size = 0;
+				while (size < block) {
+					const std::size_t available = in.AvailableBytes();
+					if (available == 0 && size > 0) break;
+					const std::span<std::byte> space = staging[index].subspan(size);
+					BlockResource resource(space);
+					auto data = in.Extract(std::clamp<std::size_t>(available, 1, space.size()), &resource);
+					if (!data) {
+						failed = true;
+						break;
+					}
+					if (data->empty()) {
+						end = true;
+						break;
+					}
+					if (data->data() != space.data()) std::memcpy(space.data(), data->data(), data->size());
+					size += data->size();
+				}
+				if (size > 0 && !failed) {
+					slots[index] = { offset, size, 0, false };
+					offset += size;
+					++waiting;
+				}
+				continue;
+			}
+			if (in_flight > 0 && !ring->Submit(1)) {
+				failed = true;
+				break;
+			}
+		}
+
+		if (in_flight > 0) context->Discard(in_flight);
+#if defined(__linux__)
+		if (start && !failed) ::lseek(fd, static_cast<off_t>(offset), SEEK_SET);
+#endif
+		if (failed) out.SetError();
+		else out.Close();
+	};
+}
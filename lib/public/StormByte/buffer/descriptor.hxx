@@ -0,0 +1,98 @@
+#pragma once
+
+#include <StormByte/buffer/typedefs.hxx>
+#include <StormByte/buffer/visibility.h>
+
+#include <cstddef>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @brief Pipeline stage reading a file descriptor until end of file.
+	 * @param fd Descriptor to read (file, pipe, socket...); it is not closed by the stage.
+	 * @param count Most bytes per read; 0 fills the free space of the stage buffer.
+	 * @return A stage meant to be the first of a Pipeline. It ignores its input and
+	 *         reads @p fd straight into its output buffer with Producer::ReadFrom(),
+	 *         closing the output at end of file or setting its error state on failure.
+	 * @see DescriptorSink(), Pipeline::AddPipe()
+	 */
+	STORMBYTE_BUFFER_PUBLIC PipeFunction DescriptorSource(int fd, std::size_t count = 0);
+
+	/**
+	 * @brief Pipeline stage writing its input to a file descriptor.
+	 * @param fd Descriptor to write; it is not closed by the stage.
+	 * @return A stage meant to be the last of a Pipeline. It writes its input straight
+	 *         from the buffer with Consumer::WriteTo() until the input is closed and
+	 *         drained, then closes its (empty) output, or sets the output error state
+	 *         when a write fails.
+	 * @see DescriptorSource(), Pipeline::AddPipe()
+	 */
+	STORMBYTE_BUFFER_PUBLIC PipeFunction DescriptorSink(int fd);
+
+	/**
+	 * @brief Pipeline stage moving a file descriptor into its output through a kernel pipe.
+	 * @param fd Descriptor to read; it is not closed by the stage.
+	 * @return DescriptorSource() using Producer::SpliceFrom(): on Linux the bytes stay in
+	 *         the kernel until a stage reads them. Paired directly with SpliceSink() they
+	 *         never reach user space; a stage in between reads them through the regular
+	 *         copying path.
+	 * @see SpliceSink(), SharedFIFO::SpliceFrom()
+	 */
+	STORMBYTE_BUFFER_PUBLIC PipeFunction SpliceSource(int fd);
+
+	/**
+	 * @brief Pipeline stage moving its input to a file descriptor through a kernel pipe.
+	 * @param fd Descriptor to write; it is not closed by the stage.
+	 * @return DescriptorSink() using Consumer::SpliceTo(), so bytes its input holds in the
+	 *         kernel are never copied to user space.
+	 * @see SpliceSource(), SharedFIFO::SpliceTo()
+	 */
+	STORMBYTE_BUFFER_PUBLIC PipeFunction SpliceSink(int fd);
+
+	/**
+	 * @brief Whether UringSource() and UringSink() run on io_uring here.
+	 * @return false when the library was built without ENABLE_IO_URING or the kernel
+	 *         refuses io_uring (older than 5.6, disabled, filtered...). The stages then
+	 *         fall back to DescriptorSource() and DescriptorSink().
+	 */
+	STORMBYTE_BUFFER_PUBLIC bool UringAvailable() noexcept;
+
+	/**
+	 * @brief Pipeline stage reading a file descriptor through io_uring until end of file.
+	 * @param fd Descriptor to read; it is not closed by the stage.
+	 * @param depth Reads kept in flight. Regular files and block devices are read at
+	 *              explicit offsets, @p depth blocks ahead. Pipes, sockets and other
+	 *              streams keep one read in flight, issued before the previous block is
+	 *              stored.
+	 * @param block Bytes per read.
+	 * @return A stage meant to be the first of a Pipeline. Reads land in @p depth blocks
+	 *         registered with the kernel and are stored in its output in file order.
+	 *         The output is closed at end of file; a failed read sets its error state.
+	 *         The file position ends after the last byte read, as with read().
+	 *         Without io_uring it behaves as DescriptorSource(fd, block).
+	 * @see UringSink(), UringAvailable()
+	 */
+	STORMBYTE_BUFFER_PUBLIC PipeFunction UringSource(int fd, std::size_t depth = 4, std::size_t block = 64 * 1024);
+
+	/**
+	 * @brief Pipeline stage writing its input to a file descriptor through io_uring.
+	 * @param fd Descriptor to write; it is not closed by the stage.
+	 * @param depth Writes kept in flight: several at explicit offsets for regular files
+	 *              and block devices not opened with O_APPEND, one for streams. The next
+	 *              block is taken from the input while writes are in flight either way.
+	 * @param block Most bytes per write.
+	 * @return A stage meant to be the last of a Pipeline. It moves its input into
+	 *         @p depth registered blocks and writes them until the input is closed and
+	 *         drained, then closes its (empty) output. A failed write sets the output
+	 *         error state instead. Without io_uring it behaves as DescriptorSink(fd).
+	 * @see UringSource(), UringAvailable()
+	 */
+	STORMBYTE_BUFFER_PUBLIC PipeFunction UringSink(int fd, std::size_t depth = 4, std::size_t block = 64 * 1024);
+}
@@ -18,18 +18,47 @@ namespace StormByte::Buffer {
             using StormByte::Exception::Exception;
     };
 
+    /**
+     * @class InsufficientData
+     * @brief Exception class for reads that cannot be satisfied.
+     *
+     * The `InsufficientData` exception is reported when a read or extract asks for
+     * more data than the buffer holds or can still receive, or the buffer is in error state.
+     *
+     * Inherits all functionality from the `StormByte::Buffer::Exception` class.
+     */
+    class STORMBYTE_BUFFER_PUBLIC InsufficientData: public Exception {
+        public:
+            using Exception::Exception;
+    };
+
     /**
      * @class BufferOverflow
      * @brief Exception class for buffer overflow errors.
      *
-     * The `BufferOverflow` exception is thrown when an operation attempts to write
-     * more data to a buffer than it can hold. This exception ensures that buffer
-     * integrity is maintained by preventing overflows.
+     * The `BufferOverflow` exception is reported when an operation attempts to write
+     * more data to a fixed capacity buffer than it can hold. This exception ensures that
+     * buffer integrity is maintained by preventing overflows.
      *
      * Inherits all functionality from the `StormByte::Buffer::Exception` class.
      */
-    class STORMBYTE_BUFFER_PUBLIC InsufficientData: public Exception {
+    class STORMBYTE_BUFFER_PUBLIC BufferOverflow: public Exception {
+        public:
+            using Exception::Exception;
+    };
+
+    /**
+     * @class IOError
+     * @brief Exception class for failed file descriptor transfers.
+     *
+     * The `IOError` exception is reported when moving bytes between a buffer and a file
+     * descriptor fails, either because the system call failed (the message describes
+     * @c errno) or because the buffer cannot take part in the transfer.
+     *
+     * Inherits all functionality from the `StormByte::Buffer::Exception` class.
+     */
+    class STORMBYTE_BUFFER_PUBLIC IOError: public Exception {
         public:
             using Exception::Exception;
     };
-}
\ No newline at end of file
+}
@@ -1,25 +1,59 @@
 #include <StormByte/buffer/fifo.hxx>
-#include <StormByte/string.hxx>
+#include <StormByte/buffer/mapping.hxx>
+#include <StormByte/buffer/numa.hxx>
+#include <StormByte/buffer/spill_file.hxx>
 
 #include <algorithm>
+#include <cstdint>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 using namespace StormByte::Buffer;
 
-FIFO::FIFO() noexcept: m_buffer(), m_position_offset(0), m_closed(false), m_error(false) {}
+namespace {
+	constexpr std::size_t StorageAlignment = 64;	// Cache line aligned storage
+
+	// Hands the whole pages inside [data, data + size) back to the OS, keeping the mapping
+	void ReleasePages([[maybe_unused]] std::byte* data, [[maybe_unused]] std::size_t size) noexcept {
+	#if defined(__linux__)
+		static const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+		const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(data) + page - 1) & ~(page - 1);
+		const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(data) + size) & ~(page - 1);
+		if (end > begin) ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+	#endif
+	}
+}
 
-FIFO::FIFO(const FIFO& other) noexcept: m_buffer(), m_position_offset(0), m_closed(false), m_error(false) {
+FIFO::FIFO() noexcept: FIFO(std::pmr::get_default_resource()) {}
+
+FIFO::FIFO(std::pmr::memory_resource* resource) noexcept: m_resource(resource), m_position_offset(0), m_closed(false), m_error(false),
+m_traces(resource) {}
+
+FIFO::FIFO(const FIFO& other) noexcept: FIFO() {
 	Copy(other);
 }
 
-FIFO::FIFO(FIFO&& other) noexcept: m_buffer(std::move(other.m_buffer)),
-m_position_offset(other.m_position_offset), m_closed(other.m_closed), m_error(other.m_error) {
+FIFO::FIFO(FIFO&& other) noexcept: m_resource(other.m_resource), m_reserved(other.m_reserved), m_retention(other.m_retention),
+m_storage(other.m_storage),
+m_position_offset(other.m_position_offset), m_closed(other.m_closed), m_error(other.m_error),
+m_traces(std::move(other.m_traces)) {
+	TakeStorage(other);
 	other.m_position_offset = 0;
 	other.m_closed = true;
 	other.m_error = true;
 }
 
 FIFO::~FIFO() {
-	Clear();
+	FreeStorage();
 }
 
 FIFO& FIFO::operator=(const FIFO& other) {
@@ -30,10 +64,21 @@ FIFO& FIFO::operator=(const FIFO& other) {
 	return *this;
 }
 
-FIFO& FIFO::operator=(FIFO&& other) noexcept {
+FIFO& FIFO::operator=(FIFO&& other) {
 	if (this != &other) {
 		Clear();
-		m_buffer = std::move(other.m_buffer);
+		if (m_resource->is_equal(*other.m_resource)) {
+			FreeStorage();
+			TakeStorage(other);
+			m_reserved = other.m_reserved;
+			m_retention = other.m_retention;
+			m_storage = other.m_storage;
+		} else {
+			// Storage cannot change resource: copy the bytes into ours, like pmr containers do
+			CopyStorage(other);
+			other.FreeStorage();
+		}
+		m_traces = std::move(other.m_traces);
 		m_position_offset = other.m_position_offset;
 		m_closed = other.m_closed;
 		other.m_position_offset = 0;
@@ -43,30 +88,79 @@ FIFO& FIFO::operator=(FIFO&& other) noexcept {
 }
 
 std::size_t FIFO::AvailableBytes() const noexcept {
-	const std::size_t current_size = m_buffer.size();
-	return (m_position_offset <= current_size) ? (current_size - m_position_offset) : 0;
+	return (m_position_offset <= m_size) ? (m_size - m_position_offset) : 0;
 }
 
 std::size_t FIFO::Size() const noexcept {
-	return m_buffer.size();
+	return m_size;
+}
+
+std::size_t FIFO::Capacity() const noexcept {
+	return m_capacity;
 }
 
 bool FIFO::Empty() const noexcept {
-	return m_buffer.empty();
+	return m_size == 0;
 }
 
 void FIFO::Clear() noexcept {
-	m_buffer.clear();
+	m_traces.OnClear();
 	m_position_offset = 0;
+	Consume(m_size);
 }
 
 void FIFO::Clean() noexcept {
-	if (m_position_offset > 0 && m_position_offset <= m_buffer.size()) {
-		m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_position_offset);
+	if (m_position_offset > 0 && m_position_offset <= m_size) {
+		const std::size_t cleaned = m_position_offset;
+		m_traces.OnRemove(cleaned, false);
 		m_position_offset = 0;
+		Consume(cleaned);
+	}
+}
+
+void FIFO::Reserve(std::size_t bytes) {
+	m_reserved = bytes;
+	if (m_capacity < bytes) Reallocate(bytes);
+	else if (m_storage.prefault && m_data != m_inline && !m_file) Mapping::Prefault(m_data, m_mirrored ? 2 * m_capacity : m_capacity);
+}
+
+void FIFO::ShrinkToFit() {
+	m_reserved = 0;
+	if (StorageCapacity(m_size) < m_capacity) Reallocate(m_size);
+}
+
+void FIFO::SetRetention(const RetentionPolicy& policy) noexcept {
+	m_retention = policy;
+}
+
+RetentionPolicy FIFO::Retention() const noexcept {
+	return m_retention;
+}
+
+void FIFO::SetStorage(const StorageOptions& options) {
+	StorageOptions effective = options;
+	if constexpr (!StorageOptions::MappingSupported) {
+		effective.mirrored = false;
+		effective.huge_pages = HugePages::None;
+		effective.lock = false;
+		effective.numa_node = StorageOptions::AnyNode;
+	}
+	if (effective.numa_node >= 0 && !Numa::Available(effective.numa_node))
+		effective.numa_node = StorageOptions::AnyNode;
+	if (effective == m_storage) return;
+	const StorageOptions previous = std::exchange(m_storage, effective);
+	try {
+		Reallocate(m_capacity);
+	} catch (...) {
+		m_storage = previous;
+		throw;
 	}
 }
 
+StorageOptions FIFO::Storage() const noexcept {
+	return m_storage;
+}
+
 void FIFO::Close() noexcept {
 	m_closed = true;
 }
@@ -81,17 +175,47 @@ bool FIFO::EoF() const noexcept {
 
 bool FIFO::Write(const std::vector<std::byte>& data) {
 	if (!IsWritable()) return false;
-	if (!data.empty())
-		m_buffer.insert(m_buffer.end(), data.begin(), data.end());
+	Append(data.data(), data.size());
 	return true;
 }
 
 bool FIFO::Write(const std::string& data) {
-	return Write(StormByte::String::ToByteVector(data));
+	if (!IsWritable()) return false;
+	// Append the string bytes directly, no intermediate byte vector
+	Append(reinterpret_cast<const std::byte*>(data.data()), data.size());
+	return true;
+}
+
+bool FIFO::Write(std::span<const std::byte> data) {
+	if (!IsWritable()) return false;
+	Append(data.data(), data.size());
+	return true;
 }
 
 ExpectedData<InsufficientData> FIFO::Read(std::size_t count) const {
-	const std::size_t available = AvailableBytes();
+	return ReadAs(count, std::vector<std::byte>());
+}
+
+ExpectedPmrData<InsufficientData> FIFO::Read(std::size_t count, std::pmr::memory_resource* resource) const {
+	return ReadAs(count, std::pmr::vector<std::byte>(resource));
+}
+
+ExpectedData<InsufficientData> FIFO::Extract(std::size_t count) {
+	return ExtractAs(count, std::vector<std::byte>());
+}
+
+ExpectedPmrData<InsufficientData> FIFO::Extract(std::size_t count, std::pmr::memory_resource* resource) {
+	return ExtractAs(count, std::pmr::vector<std::byte>(resource));
+}
+
+ExpectedSmallData<InsufficientData> FIFO::ExtractSmall(std::size_t count) {
+	return ExtractAs(count, SmallBytes());
+}
+
+template<class Vector>
+StormByte::Expected<Vector, InsufficientData> FIFO::ReadAs(std::size_t count, Vector result) const {
+	// Bytes in the storage: derived buffers may count others they have yet to bring in
+	const std::size_t available = FIFO::AvailableBytes();
 
 	if (!IsReadable()) {
 		return StormByte::Unexpected(InsufficientData("FIFO is not readable"));
@@ -112,23 +236,26 @@ ExpectedData<InsufficientData> FIFO::Read(std::size_t count) const {
 	
 	// Empty read is success
 	if (read_size == 0) {
-		return std::vector<std::byte>();
+		return result;
 	}
 
-	// Read from current position using iterator constructor for efficiency
-	auto start_it = m_buffer.begin() + m_position_offset;
-	auto end_it = start_it + read_size;
-	std::vector<std::byte> result(start_it, end_it);
+	// Read from current position, at most two contiguous runs
+	const auto [first, second] = Segments(m_position_offset, read_size);
+	result.reserve(read_size);
+	result.insert(result.end(), first.begin(), first.end());
+	result.insert(result.end(), second.begin(), second.end());
 	
 	// Advance read position
 	m_position_offset += read_size;
+	m_stats.OnRead(read_size);
 	
 	return result;
 }
 
-ExpectedData<InsufficientData> FIFO::Extract(std::size_t count) {
+template<class Vector>
+StormByte::Expected<Vector, InsufficientData> FIFO::ExtractAs(std::size_t count, Vector result) {
 	// Extract always reads from the beginning (head), not from current read position
-	const std::size_t buffer_size = m_buffer.size();
+	const std::size_t buffer_size = m_size;
 
 	if (!IsReadable()) {
 		return StormByte::Unexpected(InsufficientData("FIFO is not readable"));
@@ -149,21 +276,172 @@ ExpectedData<InsufficientData> FIFO::Extract(std::size_t count) {
 	
 	// Empty extract is success
 	if (extract_size == 0) {
-		return std::vector<std::byte>();
+		return result;
 	}
 
-	// Extract from beginning using iterator constructor for efficiency
-	std::vector<std::byte> result(m_buffer.begin(), m_buffer.begin() + extract_size);
-	
-	// Delete extracted bytes from the front of the deque
-	m_buffer.erase(m_buffer.begin(), m_buffer.begin() + extract_size);
+	// Extract from beginning, at most two contiguous runs
+	const auto [first, second] = Segments(0, extract_size);
+	result.reserve(extract_size);
+	result.insert(result.end(), first.begin(), first.end());
+	result.insert(result.end(), second.begin(), second.end());
 	
 	// Adjust the read position: if it was ahead of what we extracted, move it back
 	m_position_offset = (m_position_offset > extract_size) ? (m_position_offset - extract_size) : 0;
+	m_stats.OnExtract(extract_size);
+	m_traces.OnRemove(extract_size, true);
+
+	// Drop extracted bytes by advancing the head
+	Consume(extract_size);
 	
 	return result;
 }
 
+std::span<const std::byte> FIFO::Peek(std::size_t count) {
+	if (!IsReadable()) return {};
+	const std::size_t available = FIFO::AvailableBytes();
+	const std::size_t size = (count == 0) ? available : std::min(count, available);
+	auto segments = Segments(m_position_offset, size);
+	if (!segments.second.empty()) {
+		Linearize();
+		segments = Segments(m_position_offset, size);
+	}
+	return segments.first;
+}
+
+std::span<std::byte> FIFO::Acquire(std::size_t count) {
+	if (!IsWritable()) return {};
+	if (m_capacity - m_size < count)
+		Reallocate(std::max(m_size + count, m_capacity * 2));
+	// Free bytes after the tail, up to the end of the storage or up to the head when wrapped
+	const auto run = [this] {
+		const std::size_t end = m_head + m_size;
+		return (m_mirrored || end >= m_capacity) ? m_capacity - m_size : m_capacity - end;
+	};
+	if (run() < count) Linearize();
+	std::size_t tail = m_head + m_size;
+	if (tail >= m_capacity) tail -= m_capacity;
+	return { m_data + tail, run() };
+}
+
+bool FIFO::Commit(std::size_t count) {
+	if (!IsWritable() || count > m_capacity - m_size) return false;
+	if (count > 0) {
+		std::size_t tail = m_head + m_size;
+		if (tail >= m_capacity) tail -= m_capacity;
+		Stored(tail, count);
+	}
+	return true;
+}
+
+StormByte::Expected<std::size_t, IOError> FIFO::ReadFrom(int fd, std::size_t count) {
+	if (!IsWritable()) return StormByte::Unexpected(IOError("FIFO is not writable"));
+	return Receive(fd, count, true);
+}
+
+StormByte::Expected<std::size_t, IOError> FIFO::Receive([[maybe_unused]] int fd, std::size_t count, [[maybe_unused]] bool account) {
+#if defined(__linux__)
+	const std::size_t wanted = (count == 0) ? ReadSize : count;
+	if (m_capacity - m_size < wanted)
+		Reallocate(std::max(m_size + wanted, m_capacity * 2));
+	const auto [first, second] = FreeSegments(count == 0 ? m_capacity - m_size : count);
+	iovec vectors[2] = { { first.data(), first.size() }, { second.data(), second.size() } };
+	ssize_t result;
+	do {
+		result = ::readv(fd, vectors, second.empty() ? 1 : 2);
+	} while (result < 0 && errno == EINTR);
+	if (result < 0) return StormByte::Unexpected(IOError(std::system_category().message(errno)));
+	if (result > 0) Stored(static_cast<std::size_t>(first.data() - m_data), static_cast<std::size_t>(result), account);
+	return static_cast<std::size_t>(result);
+#else
+	(void)count;
+	return StormByte::Unexpected(IOError("File descriptor transfers are not supported on this platform"));
+#endif
+}
+
+bool FIFO::Evict(int fd, std::size_t count, std::uint64_t offset) noexcept {
+	if (count == 0) return true;
+	const auto [first, second] = Segments(m_size - count, count);
+	if (!SpillFile::Write(fd, first, second, offset)) return false;
+	m_size -= count;
+	if (m_size == 0) m_head = 0;
+	ApplyRetention();
+	return true;
+}
+
+StormByte::Expected<std::size_t, IOError> FIFO::WriteTo(int fd, std::size_t count) {
+	if (!IsReadable()) return StormByte::Unexpected(IOError("FIFO is not readable"));
+	return Transmit(fd, count, false);
+}
+
+StormByte::Expected<std::size_t, IOError> FIFO::Transmit([[maybe_unused]] int fd, std::size_t count, [[maybe_unused]] bool nowait) {
+#if defined(__linux__)
+	const std::size_t size = (count == 0) ? m_size : std::min(count, m_size);
+	if (size == 0) return 0;
+	const auto [first, second] = Segments(0, size);
+	iovec vectors[2] = {
+		{ const_cast<std::byte*>(first.data()), first.size() },
+		{ const_cast<std::byte*>(second.data()), second.size() }
+	};
+	const int parts = second.empty() ? 1 : 2;
+	ssize_t result;
+	do {
+		result = nowait ? ::pwritev2(fd, vectors, parts, -1, RWF_NOWAIT) : ::writev(fd, vectors, parts);
+	} while (result < 0 && errno == EINTR);
+	// No room, or no way to tell without blocking (kernels or descriptors without RWF_NOWAIT)
+	if (result < 0 && nowait && (errno == EAGAIN || errno == EOPNOTSUPP || errno == ENOSYS)) return 0;
+	if (result < 0) return StormByte::Unexpected(IOError(std::system_category().message(errno)));
+	const std::size_t written = static_cast<std::size_t>(result);
+	m_position_offset = (m_position_offset > written) ? (m_position_offset - written) : 0;
+	m_stats.OnExtract(written);
+	m_traces.OnRemove(written, true);
+	Consume(written);
+	return written;
+#else
+	(void)count;
+	return StormByte::Unexpected(IOError("File descriptor transfers are not supported on this platform"));
+#endif
+}
+
+StormByte::Expected<std::size_t, IOError> FIFO::MapFile([[maybe_unused]] const std::filesystem::path& path) {
+#if defined(__linux__)
+	const auto failure = [&path](int error) {
+		return StormByte::Unexpected(IOError(path.string() + ": " + std::system_category().message(error)));
+	};
+	const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) return failure(errno);
+	struct stat info;
+	const int status = ::fstat(fd, &info) != 0 ? errno : S_ISREG(info.st_mode) ? 0 : EINVAL;
+	if (status != 0) {
+		::close(fd);
+		return failure(status);
+	}
+	const std::size_t size = static_cast<std::size_t>(info.st_size);
+	std::byte* data = size > 0 ? Mapping::MapFile(fd, size) : nullptr;
+	const int error = errno;
+	// Readahead on faults follows the open file the mapping keeps
+	if (data) ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	::close(fd);
+	if (size > 0 && !data) return failure(error);
+
+	m_traces.OnClear();
+	FreeStorage();
+	if (size > 0) {
+		m_data = data;
+		m_capacity = size;
+		m_size = size;
+		m_file = true;
+		AdviseFile();
+		m_stats.OnWrite(size, m_size);
+		m_traces.OnWrite(size);
+	}
+	m_position_offset = 0;
+	m_closed = true;
+	return size;
+#else
+	return StormByte::Unexpected(IOError("Memory-mapped files are not supported on this platform"));
+#endif
+}
+
 void FIFO::Seek(const std::ptrdiff_t& offset, const Position& mode) const noexcept {
 	std::ptrdiff_t new_offset;
 	
@@ -176,15 +454,211 @@ void FIFO::Seek(const std::ptrdiff_t& offset, const Position& mode) const noexce
 	// Clamp to valid range [0, buffer.size()]
 	if (new_offset < 0) {
 		m_position_offset = 0;
-	} else if (static_cast<std::size_t>(new_offset) > m_buffer.size()) {
-		m_position_offset = m_buffer.size();
+	} else if (static_cast<std::size_t>(new_offset) > m_size) {
+		m_position_offset = m_size;
 	} else {
 		m_position_offset = static_cast<std::size_t>(new_offset);
 	}
 }
 
+Statistics FIFO::Stats() const noexcept {
+	return m_stats.Snapshot();
+}
+
+void FIFO::Append(const std::byte* data, std::size_t size, bool account) {
+	if (size > 0) {
+		if (m_capacity - m_size < size)
+			Reallocate(std::max(m_size + size, m_capacity * 2));
+		std::size_t tail = m_head + m_size;
+		if (tail >= m_capacity) tail -= m_capacity;
+		// Mirrored storage continues past its end, so the copy never splits
+		const std::size_t first = m_mirrored ? size : std::min(size, m_capacity - tail);
+		std::memcpy(m_data + tail, data, first);
+		if (first < size) std::memcpy(m_data, data + first, size - first);
+		Stored(tail, size, account);
+	}
+}
+
+void FIFO::Stored(std::size_t tail, std::size_t size, bool account) noexcept {
+	// Wrapped around: the whole storage may be resident now
+	m_dirty = (tail + size > m_capacity) ? m_capacity : std::max(m_dirty, tail + size);
+	m_size += size;
+	if (!account) return;
+	m_stats.OnWrite(size, m_size);
+	m_traces.OnWrite(size);
+}
+
 void FIFO::Copy(const FIFO& other) noexcept {
-	m_buffer = other.m_buffer;
+	CopyStorage(other);
+	m_traces = other.m_traces;
 	m_position_offset = other.m_position_offset;
 	m_closed = other.m_closed;
-}
\ No newline at end of file
+}
+
+void FIFO::CopyStorage(const FIFO& other) {
+	const bool restore = m_storage != other.m_storage;
+	m_retention = other.m_retention;
+	m_reserved = other.m_reserved;
+	m_storage = other.m_storage;
+	m_size = 0;
+	m_head = 0;
+	const std::size_t needed = std::max(other.m_size, m_reserved);
+	if (m_capacity < needed || restore) Reallocate(needed);
+	const auto [first, second] = other.Segments(0, other.m_size);
+	if (!first.empty()) std::memcpy(m_data, first.data(), first.size());
+	if (!second.empty()) std::memcpy(m_data + first.size(), second.data(), second.size());
+	m_size = other.m_size;
+	m_dirty = std::max(m_dirty, m_size);
+}
+
+std::size_t FIFO::StorageCapacity(std::size_t capacity) const noexcept {
+	if (Mapping::Required(m_storage)) return Mapping::RoundUp(capacity, m_storage);
+	return std::max(capacity, InlineCapacity);
+}
+
+void FIFO::Reallocate(std::size_t capacity) {
+	const bool mapped = Mapping::Required(m_storage);
+	capacity = StorageCapacity(capacity);
+	const bool to_inline = !mapped && capacity == InlineCapacity;
+	if (to_inline && m_data == m_inline) return;
+	std::byte* data = mapped ? Mapping::Map(capacity, m_storage)
+		: to_inline ? m_inline : static_cast<std::byte*>(m_resource->allocate(capacity, StorageAlignment));
+	if (m_storage.prefault && !to_inline) Mapping::Prefault(data, m_storage.mirrored ? 2 * capacity : capacity);
+	const auto [first, second] = Segments(0, m_size);
+	if (!first.empty()) std::memcpy(data, first.data(), first.size());
+	if (!second.empty()) std::memcpy(data + first.size(), second.data(), second.size());
+	const std::size_t size = m_size;
+	FreeStorage();
+	m_data = data;
+	m_capacity = capacity;
+	m_mapped = mapped;
+	m_mirrored = m_storage.mirrored;
+	m_size = size;
+	m_dirty = size;
+}
+
+void FIFO::FreeStorage() noexcept {
+	if (m_mapped || m_file) Mapping::Unmap(m_data, m_capacity, m_mirrored);
+	else if (m_data != m_inline) m_resource->deallocate(m_data, m_capacity, StorageAlignment);
+	m_mapped = false;
+	m_mirrored = false;
+	m_file = false;
+	m_file_ahead = 0;
+	m_file_dropped = 0;
+	m_data = m_inline;
+	m_capacity = InlineCapacity;
+	m_head = 0;
+	m_size = 0;
+	m_dirty = 0;
+}
+
+void FIFO::TakeStorage(FIFO& other) noexcept {
+	if (other.m_data == other.m_inline) {
+		std::memcpy(m_inline, other.m_inline, InlineCapacity);
+	} else {
+		m_data = other.m_data;
+		m_capacity = other.m_capacity;
+		m_mapped = other.m_mapped;
+		m_mirrored = other.m_mirrored;
+		m_file = other.m_file;
+		m_file_ahead = other.m_file_ahead;
+		m_file_dropped = other.m_file_dropped;
+	}
+	m_head = other.m_head;
+	m_size = other.m_size;
+	m_dirty = other.m_dirty;
+	other.m_data = other.m_inline;
+	other.m_mapped = false;
+	other.m_mirrored = false;
+	other.m_file = false;
+	other.FreeStorage();
+}
+
+void FIFO::Linearize() noexcept {
+	const std::size_t first = std::min(m_size, m_capacity - m_head);	// Bytes up to the end of the storage
+	const std::size_t second = m_size - first;							// Bytes wrapped to the front
+	const std::size_t gap = m_capacity - m_size;
+	if (second == 0) {
+		std::memmove(m_data, m_data + m_head, m_size);
+		m_head = 0;
+		return;
+	}
+	// Move whichever part fits in the free gap, so only the stored bytes are copied
+	if (first <= gap) {
+		std::memmove(m_data + first, m_data, second);
+		std::memcpy(m_data, m_data + m_head, first);
+		m_head = 0;
+	} else if (second <= gap) {
+		std::memmove(m_data + m_head - second, m_data + m_head, first);
+		std::memcpy(m_data + m_capacity - second, m_data, second);
+		m_head -= second;
+	} else {
+		std::rotate(m_data, m_data + m_head, m_data + m_capacity);
+		m_head = 0;
+	}
+	m_dirty = m_capacity;
+}
+
+void FIFO::Consume(std::size_t bytes) noexcept {
+	m_size -= bytes;
+	m_head = (m_size == 0) ? 0 : m_head + bytes;
+	if (m_head >= m_capacity) m_head -= m_capacity;
+	ApplyRetention();
+}
+
+void FIFO::ApplyRetention() noexcept {
+	// A mapped file never grows back: follow the head and unmap it once consumed
+	if (m_file) {
+		if (m_size == 0) FreeStorage();
+		else AdviseFile();
+		return;
+	}
+	// Shrink only once at most a quarter is in use, so the copy of the live bytes is
+	// paid for by the bytes that left since the storage last changed
+	const std::size_t spare = m_capacity - m_size;
+	if (spare > m_retention.max_spare && m_capacity > m_reserved && m_size <= m_capacity / 4) {
+		const std::size_t target = std::max(m_size + std::min(m_retention.keep_spare, m_retention.max_spare), m_reserved);
+		try {
+			if (StorageCapacity(target) < m_capacity) Reallocate(target);
+		} catch (...) {
+			// Shrinking is best effort: keep the larger storage
+		}
+	}
+	// Prefaulted or locked storage is meant to stay resident
+	const bool resident = m_storage.prefault || m_storage.lock;
+	if (m_size == 0 && m_data != m_inline && !resident && m_retention.trim_threshold > 0 && m_dirty >= m_retention.trim_threshold) {
+		if (m_mapped) Mapping::Discard(m_data, m_dirty, m_storage);
+		else ReleasePages(m_data, m_dirty);
+		m_dirty = 0;
+	}
+}
+
+std::pair<std::span<std::byte>, std::span<std::byte>> FIFO::FreeSegments(std::size_t count) noexcept {
+	if (count == 0) return {};
+	std::size_t tail = m_head + m_size;
+	if (tail >= m_capacity) tail -= m_capacity;
+	if (m_mirrored) return { { m_data + tail, count }, {} };
+	const std::size_t first = std::min(count, m_capacity - tail);
+	return { { m_data + tail, first }, { m_data, count - first } };
+}
+
+void FIFO::AdviseFile() noexcept {
+	if (m_file_ahead < m_capacity && m_head + MapWindow > m_file_ahead) {
+		const std::size_t end = std::min(m_head + 2 * MapWindow, m_capacity);
+		Mapping::ReadAhead(m_data + m_file_ahead, end - m_file_ahead);
+		m_file_ahead = end;
+	}
+	if (m_head >= m_file_dropped + MapWindow) {
+		Mapping::Drop(m_data + m_file_dropped, m_head - m_file_dropped);
+		m_file_dropped = m_head;
+	}
+}
+
+std::pair<std::span<const std::byte>, std::span<const std::byte>> FIFO::Segments(std::size_t offset, std::size_t count) const noexcept {
+	if (count == 0) return {};
+	std::size_t start = m_head + offset;
+	if (start >= m_capacity) start -= m_capacity;
+	if (m_mirrored) return { { m_data + start, count }, {} };
+	const std::size_t first = std::min(count, m_capacity - start);
+	return { { m_data + start, first }, { m_data, count - first } };
+}
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <StormByte/buffer/chunk_trace.hxx>
 #include <StormByte/buffer/position.hxx>
+#include <StormByte/buffer/retention.hxx>
+#include <StormByte/buffer/stats.hxx>
+#include <StormByte/buffer/storage.hxx>
 #include <StormByte/buffer/typedefs.hxx>
 
-#include <deque>
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <utility>
 
@@ -20,9 +27,27 @@ namespace StormByte::Buffer {
 	* @brief Byte-oriented FIFO buffer with grow-on-demand.
 	 *
 	 * @par Overview
-	*  A contiguous growable buffer implemented atop @c std::deque<std::byte> that tracks
-	*  a logical read position. It grows automatically to fit writes and supports
-	*  efficient non-destructive reads and destructive extracts.
+	*  A contiguous growable ring buffer that tracks a logical read position. It grows
+	*  automatically to fit writes and supports efficient non-destructive reads and
+	*  destructive extracts; extracting only advances the head, nothing is shifted.
+	 *
+	 * @par Capacity
+	 *  The first @ref InlineCapacity bytes of storage live inside the object, so a buffer
+	 *  carrying only small messages never allocates. Beyond that, storage grows
+	 *  geometrically and is kept within the @ref RetentionPolicy once data leaves, so a
+	 *  steady flow of writes and extracts does not allocate. Reserve() pins
+	 *  capacity up front and ShrinkToFit() gives all spare storage back.
+	 *
+	 * @par Contiguous access
+	 *  Peek() exposes stored bytes and Acquire()/Commit() let the caller write straight
+	 *  into the storage, always as one contiguous span. With the default storage a region
+	 *  crossing the end of the ring is moved first. @ref StorageOptions::mirrored maps
+	 *  the ring twice so every region is contiguous in place.
+	 *
+	 * @par Memory resource
+	 *  Storage is allocated from the @c std::pmr::memory_resource given at construction
+	 *  (the default resource otherwise), which must outlive the buffer. Read() and
+	 *  Extract() can also return their data allocated from a resource of the caller's choice.
 	 *
 	 * @par Thread safety
 	 *  This class is **not thread-safe**. For concurrent access, use @ref SharedFIFO.
@@ -36,20 +61,32 @@ namespace StormByte::Buffer {
 	 */
 	class STORMBYTE_BUFFER_PUBLIC FIFO {
 		public:
+			static constexpr std::size_t InlineCapacity = 64;		///< Storage bytes kept inside the object
+			static constexpr std::size_t ReadSize = 64 * 1024;		///< Free space ReadFrom() makes room for by default
+			static constexpr std::size_t MapWindow = 8 * 1024 * 1024;	///< Bytes of a mapped file read ahead of the head
+
 			/**
 			 * 	@brief Construct FIFO.
 			 */
 			explicit FIFO() noexcept;
 
+			/**
+			 * 	@brief Construct FIFO allocating its storage from @p resource.
+			 *  @param resource Memory resource for the stored bytes; must outlive the FIFO.
+			 */
+			explicit FIFO(std::pmr::memory_resource* resource) noexcept;
+
 			/**
 			 * 	@brief Copy construct, preserving buffer state and initial capacity.
 			 *  @param other Source FIFO to copy from.
+			 *  @note Like @c std::pmr containers, the copy uses the default memory resource.
 			 */
 			FIFO(const FIFO& other) noexcept;
 			
 			/**
 			 * 	@brief Move construct, preserving buffer state and initial capacity.
 			 *  @param other Source FIFO to move from; left empty after move.
+			 *  @note The new FIFO keeps the memory resource of @p other.
 			 */
 			FIFO(FIFO&& other) noexcept;
 
@@ -69,8 +106,11 @@ namespace StormByte::Buffer {
 			 * 	@brief Move assign, preserving buffer state and initial capacity.
 			 *  @param other Source FIFO to move from; left empty after move.
 			 *  @return Reference to this FIFO.
+			 *  @note Like @c std::pmr containers, when @p other uses a different memory resource
+			 *        the bytes are copied into this FIFO's resource, which allocates and may throw;
+			 *        with equal resources the storage is taken without allocating.
 			 */
-			FIFO& operator=(FIFO&& other) noexcept;
+			FIFO& operator=(FIFO&& other);
 
 			/**
 			 * @brief Get the number of bytes available for non-destructive reading.
@@ -92,6 +132,13 @@ namespace StormByte::Buffer {
 			 */
 			virtual std::size_t Size() const noexcept;
 
+			/**
+			 * @brief Get the number of bytes reserved by the underlying storage.
+			 * @return Storage capacity in bytes, never less than Size().
+			 * @see Size(), Reserve(), RetentionPolicy
+			 */
+			virtual std::size_t Capacity() const noexcept;
+
 			/**
 			 * @brief Check if the buffer is empty.
 			 * @return true if the buffer contains no data, false otherwise.
@@ -101,8 +148,8 @@ namespace StormByte::Buffer {
 
 			/**
 			 * @brief Clear all buffer contents.
-			 * @details Removes all data from the buffer, resets head/tail/read positions,
-			 *          and restores capacity to the initial value requested in the constructor.
+			 * @details Removes all data from the buffer and resets head/tail/read positions.
+			 *          Storage is kept as allowed by the @ref RetentionPolicy.
 			 * @see Size(), Empty()
 			 */
 			virtual void Clear() noexcept;
@@ -112,6 +159,51 @@ namespace StormByte::Buffer {
 			 */
 			virtual void Clean() noexcept;
 
+			/**
+			 * @brief Make room for at least @p bytes without further allocation.
+			 * @param bytes Capacity to reserve; also a floor the retention policy never shrinks below.
+			 * @details With StorageOptions::prefault, storage already large enough is faulted in.
+			 * @throws std::bad_alloc (or what the memory resource throws) when storage cannot grow.
+			 * @see ShrinkToFit(), Capacity()
+			 */
+			virtual void Reserve(std::size_t bytes);
+
+			/**
+			 * @brief Release all spare storage so that Capacity() equals Size().
+			 * @details Also drops the floor set by Reserve().
+			 * @see Reserve(), Capacity()
+			 */
+			virtual void ShrinkToFit();
+
+			/**
+			 * @brief Set how much spare storage is kept when data leaves the buffer.
+			 * @param policy New policy, applied the next time bytes are removed.
+			 * @see RetentionPolicy
+			 */
+			virtual void SetRetention(const RetentionPolicy& policy) noexcept;
+
+			/**
+			 * @brief Current retention policy.
+			 * @see SetRetention()
+			 */
+			virtual RetentionPolicy Retention() const noexcept;
+
+			/**
+			 * @brief Choose how the ring storage is backed.
+			 * @param options New options; stored content is moved to the new storage.
+			 * @details Options the platform cannot honour are dropped, see Storage(). Storage
+			 *          is only replaced when the options change.
+			 * @throws std::bad_alloc when the new storage cannot be created; the FIFO is unchanged.
+			 * @see StorageOptions
+			 */
+			virtual void SetStorage(const StorageOptions& options);
+
+			/**
+			 * @brief Storage options in effect.
+			 * @see SetStorage()
+			 */
+			virtual StorageOptions Storage() const noexcept;
+
 			/**
 			 * @brief Close the FIFO for further writes.
 			 * @details Marks the buffer as closed. Subsequent Write() calls will be ignored.
@@ -148,6 +240,13 @@ namespace StormByte::Buffer {
 			 */
 			virtual bool Write(const std::string& data);
 
+			/**
+			 * @brief Write any contiguous bytes to the buffer.
+			 * @param data Bytes to append (a @c std::pmr::vector, an array, ...).
+			 * @see Write(const std::vector<std::byte>&)
+			 */
+			virtual bool Write(std::span<const std::byte> data);
+
 			/**
 			 * @brief Non-destructive read from the buffer.
 			 * @param count Number of bytes to read; 0 reads all available from read position.
@@ -162,6 +261,14 @@ namespace StormByte::Buffer {
 			 */
 			virtual ExpectedData<InsufficientData> Read(std::size_t count = 0) const;
 
+			/**
+			 * @brief Non-destructive read returning data allocated from @p resource.
+			 * @param count Number of bytes to read; 0 reads all available from read position.
+			 * @param resource Memory resource for the returned vector.
+			 * @see Read(std::size_t)
+			 */
+			virtual ExpectedPmrData<InsufficientData> Read(std::size_t count, std::pmr::memory_resource* resource) const;
+
 			/**
 			 * @brief Destructive read that removes data from the buffer.
 			 * @param count Number of bytes to extract; 0 extracts all available.
@@ -176,6 +283,101 @@ namespace StormByte::Buffer {
 			 */
 			virtual ExpectedData<InsufficientData> Extract(std::size_t count = 0);
 
+			/**
+			 * @brief Destructive read returning data allocated from @p resource.
+			 * @param count Number of bytes to extract; 0 extracts all available.
+			 * @param resource Memory resource for the returned vector.
+			 * @see Extract(std::size_t)
+			 */
+			virtual ExpectedPmrData<InsufficientData> Extract(std::size_t count, std::pmr::memory_resource* resource);
+
+			/**
+			 * @brief Destructive read into a vector with inline capacity.
+			 * @param count Number of bytes to extract; 0 extracts all available.
+			 * @details Same rules as Extract(std::size_t); results of up to
+			 *          SmallBytes::InlineCapacity bytes do not allocate.
+			 * @see Extract(std::size_t), SmallBytes
+			 */
+			virtual ExpectedSmallData<InsufficientData> ExtractSmall(std::size_t count = 0);
+
+			/**
+			 * @brief Contiguous view of stored bytes from the read position, without copying them out.
+			 * @param count Bytes to view; 0 views all available. Fewer are returned when fewer are available.
+			 * @return The bytes, or an empty span when the buffer is not readable.
+			 * @details Neither the read position nor the content changes, so follow with
+			 *          Seek() and Clean() (or Extract()) to consume what was parsed. With
+			 *          default storage a region crossing the end of the ring is first moved
+			 *          to the front; with mirrored storage nothing is moved.
+			 * @warning The span is invalidated by any later call that changes the buffer.
+			 * @see Acquire(), StorageOptions::mirrored
+			 */
+			virtual std::span<const std::byte> Peek(std::size_t count = 0);
+
+			/**
+			 * @brief Contiguous writable space at the end of the buffer.
+			 * @param count Bytes the caller needs; storage grows when they do not fit.
+			 * @return At least @p count writable bytes, or an empty span when the buffer is
+			 *         not writable. Nothing is stored until Commit().
+			 * @throws std::bad_alloc (or what the memory resource throws) when storage cannot grow.
+			 * @warning The span is invalidated by any later call that changes the buffer.
+			 * @see Commit(), Peek()
+			 */
+			virtual std::span<std::byte> Acquire(std::size_t count);
+
+			/**
+			 * @brief Store the first @p count bytes of the span returned by Acquire().
+			 * @return false when the buffer is not writable or @p count exceeds the free space.
+			 * @see Acquire()
+			 */
+			virtual bool Commit(std::size_t count);
+
+			/**
+			 * @brief Append bytes read from a file descriptor straight into the storage.
+			 * @param fd Descriptor to read from (file, pipe, socket...).
+			 * @param count Most bytes to read; 0 reads up to the free space, making room for
+			 *              at least @ref ReadSize bytes.
+			 * @return Bytes stored, 0 at end of file; IOError when the buffer is not
+			 *         writable or @c readv fails (a non blocking descriptor with nothing to
+			 *         read reports @c EAGAIN).
+			 * @details One @c readv call fills the free space on both sides of the ring end,
+			 *          so no intermediate vector is needed. Interrupted calls are retried.
+			 * @throws std::bad_alloc (or what the memory resource throws) when storage cannot grow.
+			 * @see WriteTo()
+			 */
+			virtual Expected<std::size_t, IOError> ReadFrom(int fd, std::size_t count = 0);
+
+			/**
+			 * @brief Write stored bytes to a file descriptor and remove what was written.
+			 * @param fd Descriptor to write to.
+			 * @param count Most bytes to write; 0 writes everything stored.
+			 * @return Bytes written and removed from the head, like Extract(); 0 when nothing
+			 *         is stored; IOError when the buffer is not readable or @c writev fails.
+			 * @details One @c writev call covers the stored bytes on both sides of the ring
+			 *          end. A short write removes only what the descriptor accepted.
+			 * @see ReadFrom()
+			 */
+			virtual Expected<std::size_t, IOError> WriteTo(int fd, std::size_t count = 0);
+
+			/**
+			 * @brief Replace the content with a file, mapped read-only as the storage.
+			 * @param path Regular file to map.
+			 * @return Bytes mapped; IOError when the file cannot be opened or mapped, leaving
+			 *         the buffer untouched.
+			 * @details The buffer ends up closed and holding the whole file without reading
+			 *          it, however large: pages are faulted in from the page cache as they
+			 *          are used. Peek() views and WriteTo() writes the file in place, never
+			 *          copying. Up to two @ref MapWindow beyond the head are read ahead, and
+			 *          consumed pages are unmapped from the process as the head moves on.
+			 *          The mapping is released once everything is extracted. Calls that
+			 *          change the storage (Reserve(), ShrinkToFit(), SetStorage()) copy the
+			 *          remaining bytes into regular storage instead.
+			 * @warning The file must not be truncated while mapped: copying from a mapped
+			 *          page past the new end of file (Read(), Extract(), a Peek() span)
+			 *          raises SIGBUS, and WriteTo() fails on those pages.
+			 * @see Consumer::MapFile()
+			 */
+			virtual Expected<std::size_t, IOError> MapFile(const std::filesystem::path& path);
+
 			/**
 			 * @brief Check if the buffer is readable (not in error state).
 			 * @return true if readable, false if buffer is in error state.
@@ -216,11 +418,38 @@ namespace StormByte::Buffer {
 			 */
 			virtual void Seek(const std::ptrdiff_t& offset, const Position& mode) const noexcept;
 
-		protected:
 			/**
-			 * @brief Internal deque storing the buffer data.
+			 * @brief Get the usage counters of this buffer.
+			 * @return Snapshot of bytes written/read/extracted, peak size, write count and,
+			 *         for SharedFIFO, wait and notify counters.
+			 * @details Counters are only maintained when the library is built with
+			 *          @c ENABLE_STATS; otherwise all values are zero. Counters are not
+			 *          copied or moved along with the buffer contents.
+			 * @see Statistics
+			 */
+			virtual Statistics Stats() const noexcept;
+
+			/**
+			 * @brief Memory resource the stored bytes are allocated from.
 			 */
-			std::deque<std::byte> m_buffer;
+			inline std::pmr::memory_resource* MemoryResource() const noexcept { return m_resource; }
+
+		protected:
+			std::pmr::memory_resource* m_resource;					///< Resource the storage is allocated from
+			alignas(16) std::byte m_inline[InlineCapacity];			///< Inline storage, used while the content fits
+			std::byte* m_data = m_inline;							///< Ring storage: m_inline, allocated from m_resource or mapped
+			std::size_t m_capacity = InlineCapacity;				///< Size of m_data in bytes
+			std::size_t m_head = 0;									///< Index in m_data of the first stored byte
+			std::size_t m_size = 0;									///< Number of stored bytes
+			std::size_t m_reserved = 0;								///< Capacity floor set by Reserve()
+			std::size_t m_dirty = 0;								///< Leading bytes of m_data that may hold resident pages
+			RetentionPolicy m_retention;							///< Spare storage kept when data leaves
+			StorageOptions m_storage;								///< How new storage is backed
+			bool m_mapped = false;									///< m_data was mapped by the storage options, not allocated
+			bool m_mirrored = false;								///< m_data is a mirrored mapping
+			bool m_file = false;									///< m_data maps a file read-only (MapFile())
+			std::size_t m_file_ahead = 0;							///< Leading bytes of the mapped file readahead was asked for
+			std::size_t m_file_dropped = 0;							///< Leading bytes of the mapped file unmapped from the process
 
 			/**
 			 * @brief Current read position for non-destructive reads.
@@ -237,7 +466,136 @@ namespace StormByte::Buffer {
 
 			bool m_error;
 
+			/**
+			 * @brief Usage counters; empty and free when statistics are disabled.
+			 */
+			[[no_unique_address]] mutable StatisticsCounters m_stats;
+
+			/**
+			 * @brief Chunk of every stored byte; empty and free when chunk tracing is disabled.
+			 */
+			[[no_unique_address]] ChunkTraceQueue m_traces;
+
+			/**
+			 * @brief Append raw bytes at the end of the buffer.
+			 * @param data Pointer to the first byte to append.
+			 * @param size Number of bytes to append.
+			 * @param account Passed to Stored().
+			 * @details Does not check the writable state; callers do. Used by every
+			 *          Write() overload so no temporary byte vector is needed.
+			 */
+			void Append(const std::byte* data, std::size_t size, bool account = true);
+
+			/**
+			 * @brief Account for @p size bytes just placed at storage index @p tail.
+			 * @param account Whether the bytes count as newly written in the statistics and
+			 *                chunk traces; false for bytes already accounted elsewhere.
+			 */
+			void Stored(std::size_t tail, std::size_t size, bool account = true) noexcept;
+
+			/**
+			 * @brief Append up to @p count bytes read from @p fd with one @c readv, as ReadFrom().
+			 * @param account Passed to Stored().
+			 * @details Does not check the writable state; callers do.
+			 */
+			Expected<std::size_t, IOError> Receive(int fd, std::size_t count, bool account);
+
+			/**
+			 * @brief Write up to @p count stored bytes to @p fd with one @c writev, as WriteTo().
+			 * @param nowait Fail rather than wait when @p fd has no room (@c RWF_NOWAIT).
+			 * @return As WriteTo(); with @p nowait, 0 while bytes are stored means @p fd had no
+			 *         room, or does not support non blocking writes, and nothing was written.
+			 * @details Does not check the readable state; callers do.
+			 */
+			Expected<std::size_t, IOError> Transmit(int fd, std::size_t count, bool nowait);
+
+			/**
+			 * @brief Move the last @p count stored bytes to @p fd at file offset @p offset.
+			 * @return false, keeping the bytes, when they could not all be written.
+			 * @details The bytes leave the storage, not the buffer: nothing is accounted.
+			 *          @p count must not reach back past the read position.
+			 */
+			bool Evict(int fd, std::size_t count, std::uint64_t offset) noexcept;
+
 		private:
 			void Copy(const FIFO& other) noexcept;
+
+			/**
+			 * @brief Replace the contents of the storage with those of @p other.
+			 * @details Copies bytes, reserve floor, retention policy and storage options, nothing else.
+			 */
+			void CopyStorage(const FIFO& other);
+
+			/**
+			 * @brief Move the stored bytes into new storage of @p capacity bytes (>= Size()).
+			 * @details The bytes are linearized so the head restarts at 0. The capacity is
+			 *          adjusted by StorageCapacity(), and storage is prefaulted when asked to.
+			 */
+			void Reallocate(std::size_t capacity);
+
+			/**
+			 * @brief Capacity Reallocate() picks for a request of @p capacity bytes.
+			 * @details InlineCapacity up to that size; whole pages for mapped storage.
+			 */
+			std::size_t StorageCapacity(std::size_t capacity) const noexcept;
+
+			/**
+			 * @brief Return the storage to the memory resource, dropping any content.
+			 * @details Leaves the FIFO on its empty inline storage.
+			 */
+			void FreeStorage() noexcept;
+
+			/**
+			 * @brief Make the stored bytes contiguous in place, without reallocating.
+			 * @details Unwrapped content moves to the front of the storage.
+			 */
+			void Linearize() noexcept;
+
+			/**
+			 * @brief Take over the storage and content of @p other, leaving it empty.
+			 * @details Requires empty inline storage here and an equal memory resource.
+			 */
+			void TakeStorage(FIFO& other) noexcept;
+
+			/**
+			 * @brief Drop @p bytes from the head and apply the retention policy.
+			 */
+			void Consume(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Shrink or trim spare storage as the retention policy allows.
+			 */
+			void ApplyRetention() noexcept;
+
+			/**
+			 * @brief Read a mapped file ahead of the head and unmap the pages behind it.
+			 */
+			void AdviseFile() noexcept;
+
+			/**
+			 * @brief Up to two contiguous runs holding @p count stored bytes starting @p offset bytes after the head.
+			 */
+			std::pair<std::span<const std::byte>, std::span<const std::byte>> Segments(std::size_t offset, std::size_t count) const noexcept;
+
+			/**
+			 * @brief Up to two contiguous runs covering the first @p count free bytes after the tail.
+			 */
+			std::pair<std::span<std::byte>, std::span<std::byte>> FreeSegments(std::size_t count) noexcept;
+
+			/**
+			 * @brief Shared implementation of the Read() overloads.
+			 * @tparam Vector Result container type.
+			 * @param result Empty container the data is appended to (carries the allocator).
+			 */
+			template<class Vector>
+			Expected<Vector, InsufficientData> ReadAs(std::size_t count, Vector result) const;
+
+			/**
+			 * @brief Shared implementation of the Extract() overloads.
+			 * @tparam Vector Result container type.
+			 * @param result Empty container the data is appended to (carries the allocator).
+			 */
+			template<class Vector>
+			Expected<Vector, InsufficientData> ExtractAs(std::size_t count, Vector result);
 	};
 }
\ No newline at end of file
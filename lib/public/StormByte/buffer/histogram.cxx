@@ -0,0 +1,112 @@
+#include <StormByte/buffer/histogram.hxx>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+using namespace StormByte::Buffer;
+
+namespace {
+	// Values below this are stored in exact buckets
+	constexpr std::uint64_t linear_limit = 2 * LatencyHistogram::SubBuckets;
+}
+
+std::chrono::nanoseconds HistogramSnapshot::Percentile(double p) const noexcept {
+	if (count == 0 || counts.empty()) return std::chrono::nanoseconds { 0 };
+	p = std::clamp(p, 0.0, 100.0);
+	const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count))));
+	std::uint64_t seen = 0;
+	for (std::size_t i = 0; i < counts.size(); ++i) {
+		seen += counts[i];
+		if (seen >= rank) {
+			const auto bound = std::chrono::nanoseconds { static_cast<std::int64_t>(LatencyHistogram::BucketUpperBound(i)) };
+			return std::min(bound, max);
+		}
+	}
+	return max;
+}
+
+std::chrono::nanoseconds HistogramSnapshot::Mean() const noexcept {
+	if (count == 0) return std::chrono::nanoseconds { 0 };
+	return std::chrono::nanoseconds { sum.count() / static_cast<std::int64_t>(count) };
+}
+
+HistogramSnapshot& HistogramSnapshot::operator+=(const HistogramSnapshot& other) {
+	if (other.counts.empty()) return *this;
+	if (counts.empty()) counts.assign(LatencyHistogram::BucketCount, 0);
+	for (std::size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+	count += other.count;
+	sum += other.sum;
+	max = std::max(max, other.max);
+	return *this;
+}
+
+HistogramSnapshot& HistogramSnapshot::operator-=(const HistogramSnapshot& other) {
+	if (other.counts.empty() || counts.empty()) return *this;
+	for (std::size_t i = 0; i < counts.size(); ++i) counts[i] -= std::min(counts[i], other.counts[i]);
+	count -= std::min(count, other.count);
+	sum -= std::min(sum, other.sum);
+	return *this;
+}
+
+LatencyHistogram::LatencyHistogram() noexcept {
+	for (auto& stripe : m_stripes) {
+		for (auto& c : stripe.counts) c.store(0, std::memory_order_relaxed);
+		stripe.sum.store(0, std::memory_order_relaxed);
+		stripe.max.store(0, std::memory_order_relaxed);
+	}
+}
+
+void LatencyHistogram::Record(std::chrono::nanoseconds value) noexcept {
+	const std::uint64_t ns = value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+	Stripe& stripe = m_stripes[ThreadStripe()];
+	stripe.counts[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+	stripe.sum.fetch_add(ns, std::memory_order_relaxed);
+	std::uint64_t current = stripe.max.load(std::memory_order_relaxed);
+	while (ns > current && !stripe.max.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {}
+}
+
+HistogramSnapshot LatencyHistogram::Snapshot() const {
+	HistogramSnapshot snapshot;
+	snapshot.counts.assign(BucketCount, 0);
+	std::uint64_t sum = 0, max = 0;
+	for (const auto& stripe : m_stripes) {
+		for (std::size_t i = 0; i < BucketCount; ++i) {
+			const std::uint64_t c = stripe.counts[i].load(std::memory_order_relaxed);
+			snapshot.counts[i] += c;
+			snapshot.count += c;
+		}
+		sum += stripe.sum.load(std::memory_order_relaxed);
+		max = std::max(max, stripe.max.load(std::memory_order_relaxed));
+	}
+	snapshot.sum = std::chrono::nanoseconds { static_cast<std::int64_t>(sum) };
+	snapshot.max = std::chrono::nanoseconds { static_cast<std::int64_t>(max) };
+	return snapshot;
+}
+
+std::size_t LatencyHistogram::BucketIndex(std::uint64_t ns) noexcept {
+	if (ns < linear_limit) return static_cast<std::size_t>(ns);
+	const std::size_t exponent = static_cast<std::size_t>(std::bit_width(ns)) - 1;	// >= SubBucketBits + 1
+	const std::size_t sub = static_cast<std::size_t>(ns >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+	const std::size_t index = (exponent - SubBucketBits + 1) * SubBuckets + sub;
+	return std::min(index, BucketCount - 1);
+}
+
+std::uint64_t LatencyHistogram::BucketLowerBound(std::size_t index) noexcept {
+	if (index < linear_limit) return index;
+	const std::size_t exponent = index / SubBuckets + SubBucketBits - 1;
+	const std::uint64_t sub = index % SubBuckets;
+	return (SubBuckets + sub) << (exponent - SubBucketBits);
+}
+
+std::uint64_t LatencyHistogram::BucketUpperBound(std::size_t index) noexcept {
+	if (index + 1 >= BucketCount) return std::numeric_limits<std::int64_t>::max();
+	return BucketLowerBound(index + 1) - 1;
+}
+
+std::size_t LatencyHistogram::ThreadStripe() noexcept {
+	static std::atomic<std::size_t> next { 0 };
+	thread_local const std::size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % Stripes;
+	return stripe;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @struct HistogramSnapshot
+	 * @brief Immutable copy of a @ref LatencyHistogram that can be queried and merged.
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC HistogramSnapshot {
+		std::vector<std::uint64_t> counts;			///< Per bucket counts (LatencyHistogram::BucketCount entries, or empty)
+		std::uint64_t count = 0;					///< Number of recorded values
+		std::chrono::nanoseconds sum { 0 };			///< Sum of recorded values
+		std::chrono::nanoseconds max { 0 };			///< Largest recorded value
+
+		/**
+		 * @brief Estimate a percentile.
+		 * @param p Percentile in [0, 100].
+		 * @return Upper bound of the bucket holding the requested rank (capped at @ref max),
+		 *         or zero when empty. Relative error is bounded by the bucket resolution.
+		 */
+		std::chrono::nanoseconds 								Percentile(double p) const noexcept;
+
+		/**
+		 * @brief Mean of the recorded values, or zero when empty.
+		 */
+		std::chrono::nanoseconds 								Mean() const noexcept;
+
+		/**
+		 * @brief Merge another snapshot into this one.
+		 */
+		HistogramSnapshot& 										operator+=(const HistogramSnapshot& other);
+
+		/**
+		 * @brief Remove the values of an earlier snapshot of the same histogram.
+		 * @details @ref max is kept since it cannot be recomputed from buckets exactly.
+		 */
+		HistogramSnapshot& 										operator-=(const HistogramSnapshot& other);
+	};
+
+	/**
+	 * @class LatencyHistogram
+	 * @brief Lock-free log-bucketed latency histogram (HDR style).
+	 *
+	 * @par Buckets
+	 *  Values below 16 ns get exact buckets. Above that, every power of two is split
+	 *  in @ref SubBuckets linear sub-buckets, bounding the relative error to 12.5%
+	 *  up to roughly 2^49 ns. Larger values land in the last bucket.
+	 *
+	 * @par Recording
+	 *  @ref Record() only performs relaxed atomic increments on one of @ref Stripes
+	 *  cache line aligned bucket sets and never blocks. Striping is fixed at
+	 *  @ref Stripes sets, not one per thread: each thread is given a set round robin
+	 *  on first use, so with more recording threads than sets some threads share one.
+	 *  Sharing stays correct but contends on the shared cache lines. The fixed count
+	 *  keeps the histogram a fixed size and @ref Record() free of allocations.
+	 *  @ref Snapshot() sums the stripes and may run concurrently with recorders.
+	 */
+	class STORMBYTE_BUFFER_PUBLIC LatencyHistogram final {
+		public:
+			static constexpr std::size_t SubBucketBits	= 3;							///< log2 of sub-buckets per power of two
+			static constexpr std::size_t SubBuckets		= 1u << SubBucketBits;			///< Sub-buckets per power of two
+			static constexpr std::size_t BucketCount	= 48 * SubBuckets;				///< Total number of buckets
+			static constexpr std::size_t Stripes		= 4;							///< Independent bucket sets, shared when more threads record
+
+			LatencyHistogram() noexcept;
+			LatencyHistogram(const LatencyHistogram&) = delete;
+			LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+			~LatencyHistogram() = default;
+
+			/**
+			 * @brief Record one value.
+			 * @param value Latency to record; negative values are recorded as zero.
+			 */
+			void 													Record(std::chrono::nanoseconds value) noexcept;
+
+			/**
+			 * @brief Copy the current content.
+			 */
+			HistogramSnapshot 										Snapshot() const;
+
+			/**
+			 * @brief Bucket holding a value in nanoseconds.
+			 */
+			static std::size_t 										BucketIndex(std::uint64_t ns) noexcept;
+
+			/**
+			 * @brief Smallest value (in nanoseconds) held by a bucket.
+			 */
+			static std::uint64_t 									BucketLowerBound(std::size_t index) noexcept;
+
+			/**
+			 * @brief Largest value (in nanoseconds) held by a bucket.
+			 */
+			static std::uint64_t 									BucketUpperBound(std::size_t index) noexcept;
+
+		private:
+			struct alignas(64) Stripe {
+				std::array<std::atomic<std::uint64_t>, BucketCount> counts;
+				std::atomic<std::uint64_t> sum;
+				std::atomic<std::uint64_t> max;
+			};
+
+			std::array<Stripe, Stripes> m_stripes;					///< Bucket sets, assigned to threads round robin
+
+			static std::size_t 										ThreadStripe() noexcept;
+	};
+}
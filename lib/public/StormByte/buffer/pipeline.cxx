@@ -1,28 +1,77 @@
 #include <StormByte/buffer/consumer.hxx>
+#include <StormByte/buffer/numa.hxx>
 #include <StormByte/buffer/pipeline.hxx>
 #include <StormByte/buffer/producer.hxx>
+#include <StormByte/buffer/tracing.h>
 
 using namespace StormByte::Buffer;
 
-Pipeline::Pipeline(const Pipeline& other): m_pipes(other.m_pipes), m_producers(other.m_producers) {
+namespace {
+	// Runs one stage between its start/finish tracepoints
+	void RunStage([[maybe_unused]] const Pipeline* pipeline, [[maybe_unused]] std::size_t index, const PipeFunction& pipe,
+		Consumer in, Producer out, std::shared_ptr<StormByte::Logger> logger) {
+		STORMBYTE_BUFFER_PROBE2(stage__start, pipeline, index);
+		// Sync runs the last stage in the caller's thread: do not inherit its chunk context
+		if constexpr (ChunkTrace::Enabled) ChunkTracing::Clear();
+		pipe(in, out, logger);
+		STORMBYTE_BUFFER_PROBE2(stage__finish, pipeline, index);
+	}
+}
+
+Pipeline::Pipeline(const Pipeline& other): m_pipes(other.m_pipes), m_resource(other.m_resource), m_arena_size(other.m_arena_size),
+m_storage(other.m_storage), m_reserve(other.m_reserve), m_spill(other.m_spill), m_stage_nodes(other.m_stage_nodes) {
+	// Arena backed buffers die with the other pipeline's arena: do not share them
+	if (!other.m_arena) m_producers = other.m_producers;
 	m_threads.reserve(m_pipes.size() + 1);
 }
 
 Pipeline::~Pipeline() noexcept {
 	WaitForCompletion();
+	ReleaseArena();
 }
 
 Pipeline& Pipeline::operator=(const Pipeline& other) {
 	if (this != &other) {
-		m_pipes = other.m_pipes;
-		m_producers = other.m_producers;
 		WaitForCompletion();
+		ReleaseArena();
+		m_pipes = other.m_pipes;
+		m_resource = other.m_resource;
+		m_arena_size = other.m_arena_size;
+		m_storage = other.m_storage;
+		m_reserve = other.m_reserve;
+		m_spill = other.m_spill;
+		m_stage_nodes = other.m_stage_nodes;
+		if (other.m_arena) m_producers.clear();
+		else m_producers = other.m_producers;
 		m_threads.clear();
 		m_threads.reserve(m_pipes.size());
 	}
 	return *this;
 }
 
+Pipeline& Pipeline::operator=(Pipeline&& other) noexcept {
+	if (this != &other) {
+		// Finish and release our own run before its buffers are replaced
+		WaitForCompletion();
+		ReleaseArena();
+		m_pipes = std::move(other.m_pipes);
+		m_resource = other.m_resource;
+		m_producers = std::move(other.m_producers);
+		m_threads = std::move(other.m_threads);
+		m_stage_histograms = std::move(other.m_stage_histograms);
+		m_stage_baselines = std::move(other.m_stage_baselines);
+		m_stage_waits = std::move(other.m_stage_waits);
+		m_arena_size = other.m_arena_size;
+		m_arena_bytes = other.m_arena_bytes;
+		m_storage = other.m_storage;
+		m_reserve = other.m_reserve;
+		m_spill = std::move(other.m_spill);
+		m_stage_nodes = std::move(other.m_stage_nodes);
+		m_arena = std::move(other.m_arena);
+	}
+	return *this;
+}
+
 void Pipeline::AddPipe(const PipeFunction& pipe) {
 	m_pipes.push_back(pipe);
 	m_threads.reserve(m_pipes.size() + 1);
@@ -33,6 +82,11 @@ void Pipeline::AddPipe(PipeFunction&& pipe) {
 	m_threads.reserve(m_pipes.size() + 1);
 }
 
+void Pipeline::SetStageNode(std::size_t stage, int node) {
+	if (stage >= m_stage_nodes.size()) m_stage_nodes.resize(stage + 1, StorageOptions::AnyNode);
+	m_stage_nodes[stage] = node;
+}
+
 void Pipeline::SetError() noexcept {
 	for (auto& producer : m_producers) {
 		producer.SetError();
@@ -43,6 +97,12 @@ Consumer Pipeline::Process(Consumer buffer, const ExecutionMode& mode, std::shar
 	// This guards double calls and do not harm in the first call
 	WaitForCompletion();
 
+	// Fold the previous run into the per stage totals before its buffers are replaced
+	m_stage_waits = StageWaitHistograms();
+	m_stage_histograms.clear();
+	m_stage_baselines.clear();
+	ReleaseArena();
+
 	// Use pre-created producers corresponding to each pipe
 	if (m_pipes.empty()) {
 		// If there are not any stages, we do a passthrough
@@ -52,8 +112,25 @@ Consumer Pipeline::Process(Consumer buffer, const ExecutionMode& mode, std::shar
 	// Reset producers to ensure a fresh run when reusing the pipeline
 	m_producers.clear();
 	m_producers.resize(m_pipes.size());
-	for (auto& prod : m_producers) {
-		prod = Producer();
+	if (m_arena_size > 0)
+		m_arena = std::make_unique<Arena>(m_arena_size, m_resource ? m_resource : std::pmr::get_default_resource());
+	for (std::size_t i = 0; i < m_producers.size(); ++i) {
+		// The output buffer outlives the run, so it never lives in the arena
+		if (m_arena && i + 1 < m_producers.size())
+			m_producers[i] = Producer(m_arena.get());
+		else
+			m_producers[i] = m_resource ? Producer(m_resource) : Producer();
+		StorageOptions storage = m_storage;
+		if (i < m_stage_nodes.size() && m_stage_nodes[i] != StorageOptions::AnyNode) storage.numa_node = m_stage_nodes[i];
+		if (storage != StorageOptions {} || m_reserve > 0) {
+			try {
+				m_producers[i].SetStorage(storage);
+				m_producers[i].Reserve(m_reserve);
+			} catch (...) {
+				// Best effort: the buffer keeps whatever storage it could get
+			}
+		}
+		if (m_spill.threshold > 0) m_producers[i].SetSpill(m_spill);
 	}
 
 	// Prepare storage for worker threads. We'll create threads for the first
@@ -66,25 +143,32 @@ Consumer Pipeline::Process(Consumer buffer, const ExecutionMode& mode, std::shar
 	for (std::size_t i = 0; i < m_pipes.size(); ++i) {
 		Consumer stage_in = (i == 0) ? buffer : m_producers[i - 1].Consumer();
 		Producer stage_out = m_producers[i];
+		const int node = i < m_stage_nodes.size() ? m_stage_nodes[i] : StorageOptions::AnyNode;
+
+		auto histogram = stage_in.WaitHistogram();
+		m_stage_baselines.push_back(histogram ? histogram->Snapshot() : HistogramSnapshot {});
+		m_stage_histograms.push_back(std::move(histogram));
 
 		// First N-1 stages: create a background thread and store it.
 		if (i < m_pipes.size() - 1) {
-			m_threads.emplace_back([pipe = m_pipes[i], in = stage_in, out = stage_out, logger]() mutable {
-				pipe(in, out, logger);
+			m_threads.emplace_back([this, i, node, pipe = m_pipes[i], in = stage_in, out = stage_out, logger]() mutable {
+				Numa::RunOn(node);
+				RunStage(this, i, pipe, in, out, logger);
 			});
 			continue;
 		}
 
 		// Last stage: detached/threaded only for Async; for Sync run inline.
 		if (mode == ExecutionMode::Async) {
-			m_threads.emplace_back([pipe = m_pipes[i], in = stage_in, out = stage_out, logger]() mutable {
-				pipe(in, out, logger);
+			m_threads.emplace_back([this, i, node, pipe = m_pipes[i], in = stage_in, out = stage_out, logger]() mutable {
+				Numa::RunOn(node);
+				RunStage(this, i, pipe, in, out, logger);
 			});
 		} else {
 			// Run last stage inline for Sync semantics. After returning from
 			// this call we join all worker threads to ensure deterministic
 			// completion.
-			m_pipes[i](stage_in, stage_out, logger);
+			RunStage(this, i, m_pipes[i], stage_in, stage_out, logger);
 			for (auto &t : m_threads) {
 				if (t.joinable()) t.join();
 			}
@@ -92,9 +176,32 @@ Consumer Pipeline::Process(Consumer buffer, const ExecutionMode& mode, std::shar
 		}
 	}
 
+	// Sync: the run is over and every stage handle is gone
+	if (mode == ExecutionMode::Sync) ReleaseArena();
+
 	return m_producers.back().Consumer();
 }
 
+std::size_t Pipeline::ArenaBytes() const noexcept {
+	return m_arena ? m_arena->Allocated() : m_arena_bytes;
+}
+
+std::vector<HistogramSnapshot> Pipeline::StageWaitHistograms() const {
+	std::vector<HistogramSnapshot> result(m_pipes.size());
+	if constexpr (Statistics::Enabled) {
+		for (auto& stage : result) stage.counts.assign(LatencyHistogram::BucketCount, 0);
+	}
+	for (std::size_t i = 0; i < result.size() && i < m_stage_waits.size(); ++i)
+		result[i] += m_stage_waits[i];
+	for (std::size_t i = 0; i < result.size() && i < m_stage_histograms.size(); ++i) {
+		if (!m_stage_histograms[i]) continue;
+		HistogramSnapshot current = m_stage_histograms[i]->Snapshot();
+		current -= m_stage_baselines[i];
+		result[i] += current;
+	}
+	return result;
+}
+
 void Pipeline::WaitForCompletion() {
 	for (std::size_t i = 0; i < m_threads.size(); ++i) {
 		if (m_threads[i].joinable()) {
@@ -103,4 +210,13 @@ void Pipeline::WaitForCompletion() {
 	}
 	m_threads.clear();
 	m_threads.reserve(m_pipes.size());
-}
\ No newline at end of file
+}
+
+void Pipeline::ReleaseArena() noexcept {
+	if (!m_arena) return;
+	// Intermediate buffers live in the arena: destroy them before it
+	if (m_producers.size() > 1)
+		m_producers.erase(m_producers.begin(), m_producers.end() - 1);
+	m_arena_bytes = m_arena->Allocated();
+	m_arena.reset();
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <StormByte/buffer/arena.hxx>
 #include <StormByte/buffer/consumer.hxx>
 #include <StormByte/buffer/producer.hxx>
 #include <StormByte/buffer/typedefs.hxx>
@@ -117,6 +118,11 @@ namespace StormByte::Buffer {
     *  - Buffers grow automatically to accommodate data flow
     *  - Blocking operations minimize busy-waiting
     *  - Async detached threads mean pipeline setup returns immediately
+    *  - SetArenaSize() backs the intermediate buffers of each run with a single Arena
+    *    released in bulk once the run is over, instead of piecemeal heap traffic
+    *  - SetStorage() prefaults, locks or maps huge pages for the buffers of each run
+    *  - SetStageNode() keeps a stage thread and the buffer it writes on the same NUMA node
+    *  - SetSpill() lets a buffer in front of a stalled stage overflow to disk instead of memory
      *
     * @warning Async: Pipeline functions run in detached threads. Ensure all captured data
     *          remains valid for the thread's lifetime (use value capture or shared_ptr).
@@ -132,9 +138,17 @@ namespace StormByte::Buffer {
              */
             Pipeline() noexcept										= default;
 
+            /**
+             * @brief Construct a pipeline whose intermediate buffers allocate from @p resource.
+             * @param resource Memory resource for every inter-stage buffer created by Process();
+             *        must outlive the pipeline and every Consumer it returned.
+             */
+            explicit Pipeline(std::pmr::memory_resource* resource) noexcept: m_resource(resource) {}
+
             /**
              * @brief Copy constructor
              * Creates a new `Pipeline` that shares the same underlying buffer as the original.
+             * Arena backed intermediate buffers are not shared (see SetArenaSize()).
              * @param other Pipeline to copy
              */
             Pipeline(const Pipeline& other);
@@ -163,7 +177,7 @@ namespace StormByte::Buffer {
              * @param other `Pipeline` instance to move from
              * @return Reference to the updated `Pipeline` instance
              */
-            Pipeline& operator=(Pipeline&& other) noexcept			= default;
+            Pipeline& operator=(Pipeline&& other) noexcept;
 
             /**
              * @brief Add a processing stage to the pipeline.
@@ -224,15 +238,107 @@ namespace StormByte::Buffer {
              */
             Consumer												Process(Consumer buffer, const ExecutionMode& mode, std::shared_ptr<Logger> logger) noexcept;
 
+            /**
+             * @brief Time each stage spent blocked reading its input, aggregated over every run.
+             * @return One histogram per stage (in AddPipe() order) holding the blocking waits on
+             *         that stage's input buffer across all Process() calls of this instance,
+             *         including the one in progress. Empty histograms unless built with ENABLE_STATS.
+             * @details Stage 0 reads the buffer passed to Process(), so waits by other readers of
+             *          that buffer are included as well.
+             * @see LatencyHistogram, SharedFIFO::WaitHistogram()
+             */
+            std::vector<HistogramSnapshot>							StageWaitHistograms() const;
+
+            /**
+             * @brief Back the intermediate data of every Process() call with a per-run Arena.
+             * @param initial_size Size of the arena's first chunk; 0 (the default) disables the arena.
+             * @details When enabled, each run creates an Arena (upstream: the resource given at
+             *          construction, or the default heap) holding every inter-stage buffer object
+             *          and its storage. Stages may allocate their result vectors there too through
+             *          Consumer::Extract(count, in.MemoryResource()). The arena is released in bulk
+             *          when the run is known to be over: at the end of a Sync Process(), otherwise
+             *          when the next Process() or the destructor joins the stage threads.
+             *          The buffer returned by Process() escapes the run and is never arena backed.
+             * @warning The arena never reuses freed memory, so it grows with all data that flows
+             *          through the intermediate buffers: it suits bounded, request sized runs.
+             *          Stages must not keep their Consumer/Producer beyond the run.
+             * @see Arena
+             */
+            inline void 											SetArenaSize(std::size_t initial_size) noexcept { m_arena_size = initial_size; }
+
+            /**
+             * @brief Storage options and reserved capacity for every buffer created by Process().
+             * @param options Storage of each inter-stage buffer and of the returned buffer.
+             * @param reserve Capacity reserved in each of them up front; 0 reserves nothing.
+             * @details With StorageOptions::prefault or StorageOptions::lock and a reserve
+             *          covering the data in flight, stages never take a page fault on their
+             *          buffers. Best effort: a buffer whose storage cannot be created keeps
+             *          the default storage.
+             * @see StorageOptions, FIFO::SetStorage(), FIFO::Reserve()
+             */
+            inline void 											SetStorage(const StorageOptions& options, std::size_t reserve = 0) noexcept {
+                m_storage = options;
+                m_reserve = reserve;
+            }
+
+            /**
+             * @brief Spill policy for every buffer created by Process().
+             * @param policy Applied to each inter-stage buffer and to the returned buffer;
+             *               a zero threshold (the default) keeps everything in memory.
+             * @details A stage that stalls then makes the stage before it write to disk rather
+             *          than grow its output buffer without bound, and reads catch up from the
+             *          file once it resumes. Stages see no difference.
+             * @see SpillPolicy, SharedFIFO::SetSpill()
+             */
+            inline void 											SetSpill(const SpillPolicy& policy) { m_spill = policy; }
+
+            /**
+             * @brief Run a stage on a NUMA node, next to the buffer it writes.
+             * @param stage Stage index, in AddPipe() order.
+             * @param node NUMA node, or StorageOptions::AnyNode to undo a previous placement.
+             * @details From the next Process() call, the stage thread is restricted to the CPUs
+             *          of @p node and its output buffer is allocated on that node's memory,
+             *          overriding StorageOptions::numa_node from SetStorage() for that buffer.
+             *          The stage reading that buffer is usually best placed on the same node.
+             *          Best effort: an unknown node places nothing, and a Sync run executes its
+             *          last stage in the caller's thread, which is never moved.
+             * @see StorageOptions::numa_node
+             */
+            void 													SetStageNode(std::size_t stage, int node);
+
+            /**
+             * @brief Bytes allocated from the arena by the current run, or by the last one if it was released.
+             * @return 0 when no run used an arena.
+             * @see SetArenaSize()
+             */
+            std::size_t 											ArenaBytes() const noexcept;
+
         private:
             std::vector<PipeFunction> m_pipes;						///< Vector of pipe functions
+			std::pmr::memory_resource* m_resource = nullptr;		///< Resource for intermediate buffers; nullptr for the default heap
 			std::vector<Producer> m_producers;						///< Vector of intermediate consumers
 			std::vector<std::thread> m_threads;						///< Vector of threads for execution
+			std::vector<std::shared_ptr<const LatencyHistogram>> m_stage_histograms;	///< Input wait histogram of each stage for the current run
+			std::vector<HistogramSnapshot> m_stage_baselines;		///< Content of m_stage_histograms when the current run started
+			std::vector<HistogramSnapshot> m_stage_waits;			///< Stage waits accumulated from finished runs
+			std::size_t m_arena_size = 0;							///< Initial size of the per-run arena; 0 disables it
+			std::size_t m_arena_bytes = 0;							///< Arena usage of the last released run
+			StorageOptions m_storage;								///< Storage options of the buffers created by Process()
+			std::size_t m_reserve = 0;								///< Capacity reserved in the buffers created by Process()
+			SpillPolicy m_spill;									///< Spill policy of the buffers created by Process()
+			std::vector<int> m_stage_nodes;							///< NUMA node of each stage; StorageOptions::AnyNode or missing for none
+			std::unique_ptr<Arena> m_arena;							///< Arena of the current run; must outlive m_producers' intermediate buffers
 
 			/**
 			 * @brief Wait for all pipeline threads to complete.
 			 * @details Joins the last thread (if async mode) to ensure pipeline completion and clear threads for next run
 			 */
 			void 													WaitForCompletion();
+
+			/**
+			 * @brief Drop the intermediate buffers of the finished run and release its arena.
+			 * @details Keeps the output buffer, which is never arena backed. No-op without arena.
+			 */
+			void 													ReleaseArena() noexcept;
     };
 }
\ No newline at end of file
@@ -33,6 +33,14 @@ namespace StormByte::Buffer {
              */
             inline Producer() noexcept: m_buffer(std::make_shared<SharedFIFO>()) {};
 
+            /**
+             * @brief Construct a Producer whose new SharedFIFO lives in @p resource.
+             * @param resource Memory resource for the buffer object and its storage;
+             *        must outlive every Producer and Consumer sharing the buffer.
+             */
+            explicit Producer(std::pmr::memory_resource* resource):
+            m_buffer(std::allocate_shared<SharedFIFO>(std::pmr::polymorphic_allocator<SharedFIFO>(resource), resource)) {}
+
 			/**
              * @brief Construct a Producer from a Consumer's buffer.
              * @details Creates a new Producer instance sharing the same underlying
@@ -94,6 +102,38 @@ namespace StormByte::Buffer {
 			 */
 			inline bool IsWritable() const noexcept { return m_buffer->IsWritable(); }
 
+			/**
+			 * @brief Get the usage counters of the underlying buffer.
+			 * @return Snapshot of the shared buffer statistics (zero unless built with ENABLE_STATS).
+			 * @see SharedFIFO::Stats(), Statistics
+			 */
+			inline Statistics Stats() const noexcept { return m_buffer->Stats(); }
+
+			/**
+			 * @brief Histogram of the time readers of the shared buffer spent blocked.
+			 * @return Live histogram handle, or nullptr when statistics are disabled.
+			 * @see SharedFIFO::WaitHistogram(), LatencyHistogram
+			 */
+			inline std::shared_ptr<const LatencyHistogram> WaitHistogram() const { return m_buffer->WaitHistogram(); }
+
+			/**
+			 * @brief Choose how the shared buffer backs its storage.
+			 * @see SharedFIFO::SetStorage(), StorageOptions
+			 */
+			inline void SetStorage(const StorageOptions& options) { m_buffer->SetStorage(options); }
+
+			/**
+			 * @brief Reserve capacity in the shared buffer.
+			 * @see SharedFIFO::Reserve()
+			 */
+			inline void Reserve(std::size_t bytes) { m_buffer->Reserve(bytes); }
+
+			/**
+			 * @brief Choose when the shared buffer spills unread bytes to disk.
+			 * @see SharedFIFO::SetSpill(), SpillPolicy
+			 */
+			inline void SetSpill(const SpillPolicy& policy) { m_buffer->SetSpill(policy); }
+
 			/**
 			 * @brief Write bytes to the buffer.
 			 * @param data Byte vector to append.
@@ -110,6 +150,27 @@ namespace StormByte::Buffer {
 			 */
 			inline bool Write(const std::string& data) { return m_buffer->Write(data); }
 
+			/**
+			 * @brief Write any contiguous bytes to the buffer.
+			 * @param data Bytes to append (a @c std::pmr::vector, an array, ...).
+			 * @see SharedFIFO::Write(std::span<const std::byte>)
+			 */
+			inline bool Write(std::span<const std::byte> data) { return m_buffer->Write(data); }
+
+			/**
+			 * @brief Append bytes read from a file descriptor without an intermediate copy.
+			 * @return Bytes stored, 0 at end of file, or IOError.
+			 * @see SharedFIFO::ReadFrom(), DescriptorSource()
+			 */
+			inline Expected<std::size_t, IOError> ReadFrom(int fd, std::size_t count = 0) { return m_buffer->ReadFrom(fd, count); }
+
+			/**
+			 * @brief Move bytes from a file descriptor into the buffer through a kernel pipe (Linux).
+			 * @return Bytes moved, 0 at end of file, or IOError.
+			 * @see SharedFIFO::SpliceFrom(), SpliceSource()
+			 */
+			inline Expected<std::size_t, IOError> SpliceFrom(int fd, std::size_t count = 0) { return m_buffer->SpliceFrom(fd, count); }
+
 			/**
 			 * @brief Create a Consumer for reading from this Producer's buffer.
 			 * @return A Consumer instance sharing the underlying buffer.
@@ -0,0 +1,95 @@
+#include <StormByte/buffer/prometheus_exporter.hxx>
+
+#include <fstream>
+#include <sstream>
+
+using namespace StormByte::Buffer;
+
+namespace {
+	// Emits HELP/TYPE headers followed by one sample per buffer
+	template<typename Getter>
+	void family(std::ostringstream& out, const std::string& name, const char* type, const char* help,
+				const std::vector<BufferSnapshot>& snapshots, Getter&& get) {
+		out << "# HELP " << name << ' ' << help << '\n'
+			<< "# TYPE " << name << ' ' << type << '\n';
+		for (const auto& s : snapshots)
+			out << name << "{id=\"" << s.id << "\"} " << get(s) << '\n';
+	}
+
+	void scalar(std::ostringstream& out, const std::string& name, const char* help, std::size_t value) {
+		out << "# HELP " << name << ' ' << help << '\n'
+			<< "# TYPE " << name << " gauge\n"
+			<< name << ' ' << value << '\n';
+	}
+}
+
+std::string PrometheusExporter::Render(const std::string& prefix) {
+	return Render(Registry::Instance().Snapshot(), prefix);
+}
+
+std::string PrometheusExporter::Render(const std::vector<BufferSnapshot>& snapshots, const std::string& prefix) {
+	std::size_t size = 0, capacity = 0, waiters = 0;
+	for (const auto& s : snapshots) {
+		size += s.size;
+		capacity += s.capacity;
+		waiters += s.waiters;
+	}
+
+	std::ostringstream out;
+	scalar(out, prefix + "_count", "Number of live registered buffers.", snapshots.size());
+	scalar(out, prefix + "_size_bytes_sum", "Bytes stored across all registered buffers.", size);
+	scalar(out, prefix + "_capacity_bytes_sum", "Bytes reserved across all registered buffers.", capacity);
+	scalar(out, prefix + "_waiters_sum", "Threads blocked on any registered buffer.", waiters);
+
+	family(out, prefix + "_size_bytes", "gauge", "Bytes stored in the buffer.", snapshots,
+		[](const BufferSnapshot& s) { return s.size; });
+	family(out, prefix + "_capacity_bytes", "gauge", "Bytes reserved by the buffer storage.", snapshots,
+		[](const BufferSnapshot& s) { return s.capacity; });
+	family(out, prefix + "_available_bytes", "gauge", "Bytes readable from the read position.", snapshots,
+		[](const BufferSnapshot& s) { return s.available; });
+	family(out, prefix + "_waiters", "gauge", "Threads blocked reading the buffer.", snapshots,
+		[](const BufferSnapshot& s) { return s.waiters; });
+	family(out, prefix + "_closed", "gauge", "1 if the buffer is closed for writes.", snapshots,
+		[](const BufferSnapshot& s) { return s.closed ? 1 : 0; });
+	family(out, prefix + "_error", "gauge", "1 if the buffer is in error state.", snapshots,
+		[](const BufferSnapshot& s) { return s.error ? 1 : 0; });
+
+	if constexpr (Statistics::Enabled) {
+		family(out, prefix + "_written_bytes_total", "counter", "Bytes written to the buffer.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.bytes_written; });
+		family(out, prefix + "_read_bytes_total", "counter", "Bytes read without removal.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.bytes_read; });
+		family(out, prefix + "_extracted_bytes_total", "counter", "Bytes extracted from the buffer.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.bytes_extracted; });
+		family(out, prefix + "_peak_size_bytes", "gauge", "Largest size reached by the buffer.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.peak_size; });
+		family(out, prefix + "_writes_total", "counter", "Write operations.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.writes; });
+		family(out, prefix + "_waits_total", "counter", "Times a reader blocked.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.waits; });
+		family(out, prefix + "_wait_seconds_total", "counter", "Time readers spent blocked.", snapshots,
+			[](const BufferSnapshot& s) { return std::chrono::duration<double>(s.stats.wait_time).count(); });
+		family(out, prefix + "_notifies_total", "counter", "Wake-up notifications sent.", snapshots,
+			[](const BufferSnapshot& s) { return s.stats.notifies; });
+	}
+	return out.str();
+}
+
+bool PrometheusExporter::Write(const std::filesystem::path& path, const std::string& prefix) {
+	const std::string content = Render(prefix);
+	std::filesystem::path temporary = path;
+	temporary += ".tmp";
+	{
+		std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+		if (!out) return false;
+		out << content;
+		if (!out.good()) return false;
+	}
+	std::error_code ec;
+	std::filesystem::rename(temporary, path, ec);
+	if (ec) {
+		std::filesystem::remove(temporary, ec);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <StormByte/buffer/registry.hxx>
+
+#include <filesystem>
+#include <string>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @class PrometheusExporter
+	 * @brief Renders @ref Registry snapshots in the Prometheus text exposition format.
+	 *
+	 * @par Metrics
+	 *  Aggregates: @c stormbyte_buffer_count, @c stormbyte_buffer_size_bytes_sum,
+	 *  @c stormbyte_buffer_capacity_bytes_sum and @c stormbyte_buffer_waiters_sum.
+	 *  Per buffer (label @c id): size, capacity, available bytes, waiters, closed and
+	 *  error gauges; with @c ENABLE_STATS also the usage counters.
+	 *
+	 * @par Usage
+	 *  @code
+	 *  Registry::Enable();
+	 *  // ... create buffers, run pipelines ...
+	 *  PrometheusExporter::Write("/var/lib/node_exporter/stormbyte_buffer.prom");
+	 *  @endcode
+	 */
+	class STORMBYTE_BUFFER_PUBLIC PrometheusExporter final {
+		public:
+			PrometheusExporter() = delete;
+
+			/**
+			 * @brief Render the current registry content.
+			 * @param prefix Metric name prefix.
+			 * @return Prometheus text format document.
+			 */
+			static std::string 										Render(const std::string& prefix = "stormbyte_buffer");
+
+			/**
+			 * @brief Render the given snapshots.
+			 * @param snapshots Buffer snapshots, usually from Registry::Snapshot().
+			 * @param prefix Metric name prefix.
+			 * @return Prometheus text format document.
+			 */
+			static std::string 										Render(const std::vector<BufferSnapshot>& snapshots, const std::string& prefix = "stormbyte_buffer");
+
+			/**
+			 * @brief Render the current registry content to a file.
+			 * @param path Destination file.
+			 * @param prefix Metric name prefix.
+			 * @return true on success.
+			 * @details Writes to a temporary file next to @p path and renames it, so
+			 *          collectors (e.g. node_exporter textfile) never read partial output.
+			 */
+			static bool 											Write(const std::filesystem::path& path, const std::string& prefix = "stormbyte_buffer");
+	};
+}
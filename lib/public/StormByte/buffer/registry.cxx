@@ -0,0 +1,53 @@
+#include <StormByte/buffer/registry.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+
+#include <algorithm>
+
+using namespace StormByte::Buffer;
+
+std::atomic<bool> Registry::s_enabled { false };
+
+Registry& Registry::Instance() {
+	// Leaked on purpose: buffers with static storage duration may unregister after exit handlers ran
+	static Registry* instance = new Registry();
+	return *instance;
+}
+
+void Registry::Enable(bool enabled) noexcept {
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Registry::IsEnabled() noexcept {
+	return s_enabled.load(std::memory_order_relaxed);
+}
+
+std::vector<BufferSnapshot> Registry::Snapshot() const {
+	std::vector<BufferSnapshot> snapshots;
+	// Holding the registry lock keeps every listed buffer alive: destructors unregister first
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	snapshots.reserve(m_buffers.size());
+	for (const auto& [buffer, id] : m_buffers)
+		snapshots.push_back(buffer->Snapshot(id));
+	std::sort(snapshots.begin(), snapshots.end(), [](const BufferSnapshot& a, const BufferSnapshot& b) {
+		return a.id < b.id;
+	});
+	return snapshots;
+}
+
+std::size_t Registry::Count() const {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return m_buffers.size();
+}
+
+std::uint64_t Registry::Register(const SharedFIFO* buffer) {
+	if (!IsEnabled()) return 0;
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	const std::uint64_t id = m_next_id++;
+	m_buffers.emplace(buffer, id);
+	return id;
+}
+
+void Registry::Unregister(const SharedFIFO* buffer) noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	m_buffers.erase(buffer);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <StormByte/buffer/stats.hxx>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	class SharedFIFO;
+
+	/**
+	 * @struct BufferSnapshot
+	 * @brief Point in time view of a registered buffer.
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC BufferSnapshot {
+		std::uint64_t id		= 0;		///< Registry assigned identifier, unique for the process lifetime
+		std::size_t size		= 0;		///< Bytes stored (FIFO::Size())
+		std::size_t capacity	= 0;		///< Bytes reserved by the storage (FIFO::Capacity())
+		std::size_t available	= 0;		///< Bytes readable from the read position (FIFO::AvailableBytes())
+		std::size_t waiters		= 0;		///< Threads currently blocked in Read()/Extract()
+		bool closed				= false;	///< Closed for writes
+		bool error				= false;	///< In error state
+		Statistics stats;					///< Usage counters (zero unless built with ENABLE_STATS)
+	};
+
+	/**
+	 * @class Registry
+	 * @brief Opt-in process wide registry of live SharedFIFO buffers.
+	 *
+	 * @par Overview
+	 *  Once enabled with @ref Enable(), every @ref SharedFIFO constructed afterwards
+	 *  registers itself and unregisters on destruction. @ref Snapshot() returns the
+	 *  state of all live buffers, which @ref PrometheusExporter renders for monitoring.
+	 *  Buffers created while the registry is disabled are never registered.
+	 *
+	 * @par Cost
+	 *  While disabled, construction only checks an atomic flag. While enabled,
+	 *  construction and destruction take the registry lock once. @ref Snapshot()
+	 *  briefly takes each buffer's own lock, one buffer at a time.
+	 *
+	 * @par Thread safety
+	 *  All member functions are thread-safe.
+	 */
+	class STORMBYTE_BUFFER_PUBLIC Registry final {
+		friend class SharedFIFO;
+		public:
+			Registry(const Registry&) = delete;
+			Registry(Registry&&) = delete;
+			Registry& operator=(const Registry&) = delete;
+			Registry& operator=(Registry&&) = delete;
+
+			/**
+			 * @brief Get the process wide registry.
+			 * @details The instance is intentionally never destroyed so buffers with static
+			 *          storage duration can unregister safely at exit.
+			 */
+			static Registry& 										Instance();
+
+			/**
+			 * @brief Enable or disable registration of newly constructed buffers.
+			 * @param enabled Whether new buffers should register.
+			 * @details Disabling does not drop already registered buffers; they stay listed
+			 *          until destroyed.
+			 */
+			static void 											Enable(bool enabled = true) noexcept;
+
+			/**
+			 * @brief Check whether newly constructed buffers register.
+			 */
+			static bool 											IsEnabled() noexcept;
+
+			/**
+			 * @brief Get the state of every registered buffer.
+			 * @return One snapshot per live registered buffer, ordered by id.
+			 */
+			std::vector<BufferSnapshot> 							Snapshot() const;
+
+			/**
+			 * @brief Number of live registered buffers.
+			 */
+			std::size_t 											Count() const;
+
+		private:
+			static std::atomic<bool> s_enabled;						///< Registration switch
+			mutable std::mutex m_mutex;								///< Guards m_buffers and m_next_id
+			std::unordered_map<const SharedFIFO*, std::uint64_t> m_buffers;	///< Live buffers and their ids
+			std::uint64_t m_next_id = 1;							///< Next id to hand out
+
+			Registry() noexcept = default;
+			~Registry() = default;
+
+			/**
+			 * @brief Register a buffer.
+			 * @return Assigned id, or 0 if the registry is disabled.
+			 */
+			std::uint64_t 											Register(const SharedFIFO* buffer);
+
+			/**
+			 * @brief Remove a buffer; must be called before the buffer starts destruction.
+			 */
+			void 													Unregister(const SharedFIFO* buffer) noexcept;
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <cstddef>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @struct RetentionPolicy
+	 * @brief How much spare storage a FIFO keeps once data leaves it.
+	 *
+	 * @details Applied whenever bytes leave the buffer (Extract(), Clean(), Clear()).
+	 *          Storage is only shrunk when the spare capacity exceeds @ref max_spare and at
+	 *          most a quarter of it is in use, and then down to @ref keep_spare, so a buffer
+	 *          oscillating within that band never reallocates and draining a large buffer
+	 *          copies each byte a bounded number of times. Capacity requested with
+	 *          FIFO::Reserve() is never given back.
+	 * @see FIFO::SetRetention(), FIFO::Reserve(), FIFO::ShrinkToFit()
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC RetentionPolicy {
+		std::size_t max_spare		= 1024 * 1024;	///< Spare capacity above which storage shrinks
+		std::size_t keep_spare		= 64 * 1024;	///< Spare capacity left after shrinking (capped to max_spare)
+		/**
+		 * @brief Idle page trimming threshold; 0 disables it.
+		 * @details When the buffer drains empty and at least this many bytes of its retained
+		 *          storage were touched, their pages are handed back to the OS with
+		 *          @c madvise(MADV_DONTNEED) (Linux). Capacity is kept, so refilling does not
+		 *          allocate, it only faults pages back in.
+		 */
+		std::size_t trim_threshold	= 0;
+	};
+}
@@ -1,12 +1,130 @@
 #include <StormByte/buffer/shared_fifo.hxx>
-#include <StormByte/string.hxx>
+#include <StormByte/buffer/spill_file.hxx>
+#include <StormByte/buffer/tracing.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <memory_resource>
+#include <system_error>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace StormByte::Buffer;
 
+namespace {
+	constexpr int PipeSize = 1024 * 1024;	// Kernel pipe size asked for; the system may grant less
+	constexpr std::size_t HandoffSize = 64 * 1024;	// Most bytes WriteTo() takes out to write without the lock
+
+#if defined(__linux__)
+	/**
+	 * Per-thread pipe SpliceTo() moves bytes through: taking them out of the buffer never
+	 * waits (pipe to pipe honours SPLICE_F_NONBLOCK), and the destination, which may be a
+	 * socket that ignores it, is then waited for without the lock.
+	 */
+	struct Relay {
+		int fd[2] = { -1, -1 };
+		std::size_t capacity = 0;
+
+		Relay() noexcept {
+			if (::pipe2(fd, O_CLOEXEC) != 0) {
+				fd[0] = fd[1] = -1;
+				return;
+			}
+			::fcntl(fd[1], F_SETPIPE_SZ, PipeSize);
+			const int size = ::fcntl(fd[1], F_GETPIPE_SZ);
+			capacity = size > 0 ? static_cast<std::size_t>(size) : 64 * 1024;
+		}
+
+		~Relay() {
+			for (int end : fd)
+				if (end >= 0) ::close(end);
+		}
+
+		Relay(const Relay&) = delete;
+		Relay& operator=(const Relay&) = delete;
+
+		/**
+		 * Move the @p size bytes the pipe holds to @p target, copying them when @p target
+		 * does not take splices. On failure the bytes left are dropped and errno is kept.
+		 */
+		bool Forward(int target, std::size_t size) noexcept {
+			std::byte chunk[16 * 1024];
+			bool splicing = true;
+			while (size > 0) {
+				ssize_t result;
+				if (splicing) {
+					result = ::splice(fd[0], nullptr, target, nullptr, size, SPLICE_F_MOVE);
+					if (result < 0 && errno == EINVAL) {
+						splicing = false;
+						continue;
+					}
+				} else {
+					result = ::read(fd[0], chunk, std::min(size, sizeof(chunk)));
+					for (ssize_t done = 0; result > 0 && done < result;) {
+						const ssize_t written = ::write(target, chunk + done, static_cast<std::size_t>(result - done));
+						if (written > 0) done += written;
+						else if (written == 0 || errno != EINTR) {
+							// What was read is gone either way
+							if (written == 0) errno = EPIPE;
+							size -= static_cast<std::size_t>(result);
+							result = -1;
+						}
+					}
+				}
+				if (result < 0 && errno == EINTR) continue;
+				if (result <= 0) {
+					const int error = result == 0 ? EPIPE : errno;
+					Discard(size);
+					errno = error;
+					return false;
+				}
+				size -= static_cast<std::size_t>(result);
+			}
+			return true;
+		}
+
+		void Discard(std::size_t size) noexcept {
+			std::byte chunk[16 * 1024];
+			while (size > 0) {
+				const ssize_t result = ::read(fd[0], chunk, std::min(size, sizeof(chunk)));
+				if (result < 0 && errno == EINTR) continue;
+				if (result <= 0) return;
+				size -= static_cast<std::size_t>(result);
+			}
+		}
+	};
+
+	thread_local Relay relay;
+#endif
+}
+
+SharedFIFO::SharedFIFO(): SharedFIFO(std::pmr::get_default_resource()) {}
+
+SharedFIFO::SharedFIFO(std::pmr::memory_resource* resource): FIFO(resource) {
+	if (Registry::IsEnabled())
+		m_registered = Registry::Instance().Register(this) != 0;
+}
+
+SharedFIFO::~SharedFIFO() {
+	// Leave the registry before any member is destroyed so snapshots never see a dying buffer
+	if (m_registered)
+		Registry::Instance().Unregister(this);
+	ClosePipe();
+	SpillFile::Close(m_spill_fd);
+}
+
 void SharedFIFO::Close() noexcept {
 	{
 		std::scoped_lock<std::mutex> lock(m_mutex);
 		m_closed = true;
+		m_stats.OnNotify();
+		STORMBYTE_BUFFER_PROBE1(close, this);
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
 	}
 	m_cv.notify_all();
 }
@@ -15,64 +133,124 @@ void SharedFIFO::SetError() noexcept {
 	{
 		std::scoped_lock<std::mutex> lock(m_mutex);
 		m_error = true;
+		m_stats.OnNotify();
+		STORMBYTE_BUFFER_PROBE1(error, this);
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
 	}
 	m_cv.notify_all();
 }
 
 void SharedFIFO::Wait(std::size_t n, std::unique_lock<std::mutex>& lock) const {
 	if (n == 0) return;
-	m_cv.wait(lock, [&] {
+	auto ready = [&] {
 		if (m_closed) return true;
-		const std::size_t sz = m_buffer.size();
+		const std::size_t sz = m_size + m_spliced + m_spilled;
 		const std::size_t rp = m_position_offset;
 		return sz >= rp + n; // at least n bytes available from current read position
-	});
+	};
+	if (ready()) return;
+	STORMBYTE_BUFFER_PROBE3(wait__begin, this, n, m_size - m_position_offset);
+	m_waiters++;
+	if constexpr (Statistics::Enabled) {
+		const auto start = std::chrono::steady_clock::now();
+		m_cv.wait(lock, ready);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		m_stats.OnWait(elapsed);
+		if (!m_wait_histogram) m_wait_histogram = std::make_shared<LatencyHistogram>();
+		m_wait_histogram->Record(elapsed);
+	} else {
+		m_cv.wait(lock, ready);
+	}
+	m_waiters--;
+	STORMBYTE_BUFFER_PROBE2(wait__end, this, m_size - m_position_offset);
+}
+
+std::size_t SharedFIFO::WaitForRead(std::size_t count, std::unique_lock<std::mutex>& lock) const {
+	if (count != 0) Wait(count, lock);
+	Drain();
+	Refill(count == 0 ? Everything(m_position_offset) : m_position_offset + count);
+	// If closed and insufficient data, read whatever is available (may be empty)
+	if (count != 0 && m_closed && m_size - m_position_offset < count) return 0;
+	return count;
+}
+
+std::size_t SharedFIFO::WaitForExtract(std::size_t count, std::unique_lock<std::mutex>& lock) const {
+	if (count != 0) Wait(count, lock);
+	Drain();
+	Refill(count == 0 ? Everything(0) : count);
+	// If closed and insufficient data, extract whatever is available (may be empty)
+	if (count != 0 && m_closed && m_size < count) return 0;
+	return count;
 }
 
 ExpectedData<InsufficientData> SharedFIFO::Read(std::size_t count) const {
 	std::unique_lock<std::mutex> lock(m_mutex);
-	if (count != 0) {
-		Wait(count, lock);
-		// If closed and insufficient data, read whatever is available (may be empty)
-		if (m_closed) {
-			const std::size_t available = m_buffer.size() - m_position_offset;
-			if (available < count) {
-				return FIFO::Read(0); // Read all available (returns empty vector if none)
-			}
-		}
-	}
-	return FIFO::Read(count);
+	return FIFO::Read(WaitForRead(count, lock));
+}
+
+ExpectedPmrData<InsufficientData> SharedFIFO::Read(std::size_t count, std::pmr::memory_resource* resource) const {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return FIFO::Read(WaitForRead(count, lock), resource);
 }
 
 ExpectedData<InsufficientData> SharedFIFO::Extract(std::size_t count) {
 	std::unique_lock<std::mutex> lock(m_mutex);
-	if (count != 0) {
-		Wait(count, lock);
-		// If closed and insufficient data, extract whatever is available (may be empty)
-		if (m_closed && m_buffer.size() < count) {
-			return FIFO::Extract(0); // Extract all available (returns empty vector if none)
-		}
-	}
-	return FIFO::Extract(count);
+	auto result = FIFO::Extract(WaitForExtract(count, lock));
+	STORMBYTE_BUFFER_PROBE3(extract, this, result ? result->size() : 0, m_size);
+	return result;
+}
+
+ExpectedPmrData<InsufficientData> SharedFIFO::Extract(std::size_t count, std::pmr::memory_resource* resource) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto result = FIFO::Extract(WaitForExtract(count, lock), resource);
+	STORMBYTE_BUFFER_PROBE3(extract, this, result ? result->size() : 0, m_size);
+	return result;
+}
+
+ExpectedSmallData<InsufficientData> SharedFIFO::ExtractSmall(std::size_t count) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto result = FIFO::ExtractSmall(WaitForExtract(count, lock));
+	STORMBYTE_BUFFER_PROBE3(extract, this, result ? result->size() : 0, m_size);
+	return result;
 }
 
 bool SharedFIFO::Write(const std::vector<std::byte>& data) {
-	if (data.empty()) return false;
+	return WriteBytes(data.data(), data.size());
+}
+
+bool SharedFIFO::Write(const std::string& data) {
+	return WriteBytes(reinterpret_cast<const std::byte*>(data.data()), data.size());
+}
+
+bool SharedFIFO::Write(std::span<const std::byte> data) {
+	return WriteBytes(data.data(), data.size());
+}
+
+bool SharedFIFO::WriteBytes(const std::byte* data, std::size_t size) {
+	if (size == 0) return false;
+	bool stored;
 	{
 		std::scoped_lock<std::mutex> lock(m_mutex);
 		if (m_closed) return false;
-		m_buffer.insert(m_buffer.end(), data.begin(), data.end());
+		Drain();
+		stored = Store(data, size);
+		m_stats.OnNotify();
+		if (stored) {
+			STORMBYTE_BUFFER_PROBE3(write, this, size, m_size);
+		} else {
+			STORMBYTE_BUFFER_PROBE1(error, this);
+		}
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
 	}
+	// Readers wake up either way: to the new bytes, or to the error
 	m_cv.notify_all();
-	return true;
-}
-
-bool SharedFIFO::Write(const std::string& data) {
-	return Write(StormByte::String::ToByteVector(data));
+	return stored;
 }
 
 void SharedFIFO::Clear() noexcept {
 	std::scoped_lock<std::mutex> lock(m_mutex);
+	ClosePipe();
+	ClearSpill();
 	FIFO::Clear();
 }
 
@@ -81,10 +259,436 @@ void SharedFIFO::Clean() noexcept {
 	FIFO::Clean();
 }
 
+void SharedFIFO::Reserve(std::size_t bytes) {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	FIFO::Reserve(bytes);
+}
+
+void SharedFIFO::ShrinkToFit() {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	FIFO::ShrinkToFit();
+}
+
+void SharedFIFO::SetRetention(const RetentionPolicy& policy) noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	FIFO::SetRetention(policy);
+}
+
+RetentionPolicy SharedFIFO::Retention() const noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return FIFO::Retention();
+}
+
+void SharedFIFO::SetStorage(const StorageOptions& options) {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	FIFO::SetStorage(options);
+}
+
+StorageOptions SharedFIFO::Storage() const noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return FIFO::Storage();
+}
+
+std::span<const std::byte> SharedFIFO::Peek(std::size_t count) {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	Drain();
+	Refill(count == 0 ? Everything(m_position_offset) : m_position_offset + count);
+	return FIFO::Peek(count);
+}
+
+std::span<std::byte> SharedFIFO::Acquire(std::size_t count) {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	Drain();
+	return FIFO::Acquire(count);
+}
+
+bool SharedFIFO::Commit(std::size_t count) {
+	{
+		std::scoped_lock<std::mutex> lock(m_mutex);
+		if (!FIFO::Commit(count)) return false;
+		Overflow(count);
+		m_stats.OnNotify();
+		STORMBYTE_BUFFER_PROBE3(write, this, count, m_size);
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
+	}
+	m_cv.notify_all();
+	return true;
+}
+
+StormByte::Expected<std::size_t, IOError> SharedFIFO::ReadFrom(int fd, std::size_t count) {
+#if defined(__linux__)
+	// A descriptor with nothing to read must not block readers of the buffer
+	pollfd descriptor { fd, POLLIN, 0 };
+	// poll() skips negative descriptors; let readv() report them instead of waiting forever
+	while (fd >= 0 && ::poll(&descriptor, 1, -1) < 0 && errno == EINTR) {}
+#endif
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Drain();
+	auto result = FIFO::ReadFrom(fd, count);
+	if (result && *result > 0) {
+		Overflow(*result);
+		m_stats.OnNotify();
+		STORMBYTE_BUFFER_PROBE3(write, this, *result, m_size);
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
+		lock.unlock();
+		m_cv.notify_all();
+	}
+	return result;
+}
+
+StormByte::Expected<std::size_t, IOError> SharedFIFO::WriteTo(int fd, std::size_t count) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	bool blocking = false, ready = false;
+	while (true) {
+		Wait(1, lock);
+		Drain();
+		Refill(1);
+		if (!IsReadable()) return StormByte::Unexpected(IOError("FIFO is not readable"));
+		auto result = Transmit(fd, count, !blocking);
+		if (!result || *result > 0 || m_size == 0) {
+			STORMBYTE_BUFFER_PROBE3(extract, this, result ? *result : 0, m_size);
+			return result;
+		}
+#if defined(__linux__)
+		// Room reported yet refused: the descriptor cannot write without blocking (files, ttys, old kernels)
+		if (ready) {
+			// A file only waits for the disk; anything else may wait for a peer, so the bytes
+			// leave the buffer first and are written without the lock
+			struct stat info;
+			if (::fstat(fd, &info) != 0 || !(S_ISREG(info.st_mode) || S_ISBLK(info.st_mode)))
+				return Handoff(fd, count, lock);
+			blocking = true;
+			continue;
+		}
+		// No room: wait for it without holding back the other users of the buffer
+		lock.unlock();
+		pollfd descriptor { fd, POLLOUT, 0 };
+		while (::poll(&descriptor, 1, -1) < 0 && errno == EINTR) {}
+		lock.lock();
+		ready = (descriptor.revents & POLLOUT) != 0;
+#else
+		blocking = true;
+#endif
+	}
+}
+
+StormByte::Expected<std::size_t, IOError> SharedFIFO::Handoff([[maybe_unused]] int fd, std::size_t count, std::unique_lock<std::mutex>& lock) {
+#if defined(__linux__)
+	alignas(std::max_align_t) std::byte block[HandoffSize];
+	std::pmr::monotonic_buffer_resource resource(block, sizeof(block), std::pmr::null_memory_resource());
+	auto data = FIFO::Extract(std::min(count == 0 ? m_size : std::min(count, m_size), HandoffSize), &resource);
+	if (!data) return StormByte::Unexpected(IOError("FIFO is not readable"));
+	STORMBYTE_BUFFER_PROBE3(extract, this, data->size(), m_size);
+	lock.unlock();
+	for (std::size_t done = 0; done < data->size();) {
+		const ssize_t written = ::write(fd, data->data() + done, data->size() - done);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) return StormByte::Unexpected(IOError(std::system_category().message(written == 0 ? EPIPE : errno)));
+		done += static_cast<std::size_t>(written);
+	}
+	return data->size();
+#else
+	(void)count, (void)lock;
+	return StormByte::Unexpected(IOError("File descriptor transfers are not supported on this platform"));
+#endif
+}
+
+StormByte::Expected<std::size_t, IOError> SharedFIFO::MapFile(const std::filesystem::path& path) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto result = FIFO::MapFile(path);
+	if (result) {
+		ClosePipe();
+		ClearSpill();
+		m_stats.OnNotify();
+		STORMBYTE_BUFFER_PROBE1(close, this);
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
+		lock.unlock();
+		m_cv.notify_all();
+	}
+	return result;
+}
+
+StormByte::Expected<std::size_t, IOError> SharedFIFO::SpliceFrom(int fd, std::size_t count) {
+#if defined(__linux__)
+	pollfd descriptor { fd, POLLIN, 0 };
+	while (fd >= 0 && ::poll(&descriptor, 1, -1) < 0 && errno == EINTR) {}
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (!IsWritable()) return StormByte::Unexpected(IOError("FIFO is not writable"));
+	// Past the spill threshold bytes belong in the file: take the copying path
+	const bool spilling = m_spilled > 0 || (m_spill.threshold > 0 && m_size + m_spliced >= m_spill.threshold);
+	if (!spilling && OpenPipe()) {
+		// A full pipe spills into the storage, which keeps the order
+		if (m_spliced == m_pipe_capacity) Drain();
+		ssize_t result;
+		do {
+			const std::size_t room = m_pipe_capacity - m_spliced;
+			result = ::splice(fd, nullptr, m_pipe[1], nullptr, count == 0 ? room : std::min(count, room), SPLICE_F_MOVE);
+			// Out of pipe slots: spill what it holds into the storage and try again
+			if (result < 0 && errno == EAGAIN && m_spliced > 0) {
+				Drain();
+				errno = EINTR;
+			}
+		} while (result < 0 && errno == EINTR);
+		if (result > 0) {
+			const std::size_t moved = static_cast<std::size_t>(result);
+			m_spliced += moved;
+			m_stats.OnWrite(moved, m_size + m_spliced);
+			m_traces.OnWrite(moved);
+			m_stats.OnNotify();
+			STORMBYTE_BUFFER_PROBE3(write, this, moved, m_size + m_spliced);
+			STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
+			lock.unlock();
+			m_cv.notify_all();
+			return moved;
+		}
+		if (result == 0) return 0;
+		if (errno != EINVAL) return StormByte::Unexpected(IOError(std::system_category().message(errno)));
+	}
+	// The descriptor cannot be spliced: take the copying path
+	lock.unlock();
+#endif
+	return ReadFrom(fd, count);
+}
+
+StormByte::Expected<std::size_t, IOError> SharedFIFO::SpliceTo(int fd, std::size_t count) {
+#if defined(__linux__)
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Wait(1, lock);
+	// Stored bytes come first and go through WriteTo()
+	if (m_size == 0 && m_spliced > 0 && IsReadable() && relay.fd[0] >= 0) {
+		std::size_t size = count == 0 ? m_spliced.load() : std::min(count, m_spliced.load());
+		size = std::min(size, relay.capacity);
+		ssize_t result;
+		do {
+			result = ::splice(m_pipe[0], nullptr, relay.fd[1], nullptr, size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		} while (result < 0 && errno == EINTR);
+		if (result < 0) return StormByte::Unexpected(IOError(std::system_category().message(errno)));
+		const std::size_t moved = static_cast<std::size_t>(result);
+		m_spliced -= moved;
+		m_stats.OnExtract(moved);
+		m_traces.OnRemove(moved, true);
+		STORMBYTE_BUFFER_PROBE3(extract, this, moved, m_size + m_spliced);
+		// Out of the buffer: a full destination holds back this caller only
+		lock.unlock();
+		if (!relay.Forward(fd, moved))
+			return StormByte::Unexpected(IOError(std::system_category().message(errno)));
+		return moved;
+	}
+	lock.unlock();
+#endif
+	return WriteTo(fd, count);
+}
+
 void SharedFIFO::Seek(const std::ptrdiff_t& offset, const Position& mode) const noexcept {
 	{
 		std::scoped_lock<std::mutex> lock(m_mutex);
+		Drain();
+		const std::ptrdiff_t target = mode == Position::Absolute ? offset : static_cast<std::ptrdiff_t>(m_position_offset) + offset;
+		if (target > 0) Refill(static_cast<std::size_t>(target));
 		FIFO::Seek(offset, mode);
+		m_stats.OnNotify();
+		STORMBYTE_BUFFER_PROBE2(notify, this, m_waiters);
 	}
 	m_cv.notify_all();
 }
+
+Statistics SharedFIFO::Stats() const noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return FIFO::Stats();
+}
+
+std::size_t SharedFIFO::Capacity() const noexcept {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return FIFO::Capacity();
+}
+
+std::size_t SharedFIFO::AvailableBytes() const noexcept {
+	return FIFO::AvailableBytes() + m_spliced + m_spilled;
+}
+
+std::size_t SharedFIFO::Size() const noexcept {
+	return FIFO::Size() + m_spliced + m_spilled;
+}
+
+bool SharedFIFO::Empty() const noexcept {
+	return FIFO::Empty() && m_spliced == 0 && m_spilled == 0;
+}
+
+void SharedFIFO::Drain() const noexcept {
+	if (m_spliced == 0) return;
+	// Only a buffer that spliced bytes in holds any, so it was not created const
+	SharedFIFO* self = const_cast<SharedFIFO*>(this);
+	bool moved = true;
+	try {
+		while (moved && m_spliced > 0) {
+			// Already accounted when they were spliced in
+			auto result = self->Receive(m_pipe[0], m_spliced, false);
+			moved = result && *result > 0;
+			if (moved) m_spliced -= *result;
+		}
+	} catch (...) {
+		moved = false;
+	}
+	if (!moved) {
+		self->m_error = true;
+		self->ClosePipe();
+	}
+}
+
+bool SharedFIFO::OpenPipe() noexcept {
+#if defined(__linux__)
+	if (m_pipe[0] >= 0) return true;
+	if (::pipe2(m_pipe, O_CLOEXEC) != 0) {
+		m_pipe[0] = m_pipe[1] = -1;
+		return false;
+	}
+	// A full pipe (it may run out of slots before bytes) must fail rather than block under
+	// the lock; the read end stays blocking, or splicing out would not wait for the target
+	::fcntl(m_pipe[1], F_SETFL, O_NONBLOCK);
+	// Best effort: unprivileged processes are capped by /proc/sys/fs/pipe-max-size
+	::fcntl(m_pipe[1], F_SETPIPE_SZ, PipeSize);
+	const int capacity = ::fcntl(m_pipe[1], F_GETPIPE_SZ);
+	m_pipe_capacity = capacity > 0 ? static_cast<std::size_t>(capacity) : 64 * 1024;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SharedFIFO::ClosePipe() noexcept {
+#if defined(__linux__)
+	for (int& fd : m_pipe) {
+		if (fd >= 0) ::close(fd);
+		fd = -1;
+	}
+#endif
+	m_spliced = 0;
+}
+
+void SharedFIFO::SetSpill(const SpillPolicy& policy) {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	m_spill = policy;
+	if (!SpillFile::Supported()) m_spill.threshold = 0;
+}
+
+SpillPolicy SharedFIFO::Spill() const {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	return m_spill;
+}
+
+std::size_t SharedFIFO::SpilledBytes() const noexcept {
+	return m_spilled;
+}
+
+bool SharedFIFO::Store(const std::byte* data, std::size_t size) {
+	if (m_spill.threshold == 0 && m_spilled == 0) {
+		Append(data, size);
+		return true;
+	}
+	// Once bytes are spilled, the new ones go behind them whatever room memory has
+	const std::size_t room = (m_spilled > 0 || m_size >= m_spill.threshold) ? 0 : m_spill.threshold - m_size;
+	const std::size_t kept = std::min(size, room);
+	const std::size_t rest = size - kept;
+	if (rest > 0 && OpenSpill() && SpillFile::Write(m_spill_fd, { data + kept, rest }, {}, m_spill_end)) {
+		Append(data, kept, false);
+		m_spill_end += rest;
+		m_spilled += rest;
+	} else if (rest > 0 && m_spilled > 0) {
+		// Keeping them in memory would put them before the spilled ones
+		m_error = true;
+		return false;
+	} else {
+		Append(data, size, false);
+	}
+	// One chunk, however it was split between memory and disk
+	m_stats.OnWrite(size, m_size + m_spilled);
+	m_traces.OnWrite(size);
+	return true;
+}
+
+void SharedFIFO::Overflow(std::size_t appended) noexcept {
+	if (m_spilled == 0) {
+		if (m_spill.threshold == 0 || m_size <= m_spill.threshold) return;
+		// The reader keeps the oldest bytes in memory, and whatever it already read
+		appended = m_size - std::max(m_spill.threshold, m_position_offset);
+	}
+	if (appended == 0) return;
+	if (OpenSpill() && Evict(m_spill_fd, appended, m_spill_end)) {
+		m_spill_end += appended;
+		m_spilled += appended;
+	} else if (m_spilled > 0) {
+		m_error = true;
+	}
+}
+
+void SharedFIFO::Refill(std::size_t size) const noexcept {
+	if (m_spilled == 0 || m_size >= size) return;
+	// Only a buffer that wrote bytes spilled any, so it was not created const
+	SharedFIFO* self = const_cast<SharedFIFO*>(this);
+	// A whole window at a time, so the next reads find their bytes in memory
+	const std::size_t window = std::max<std::size_t>(m_spill.read_ahead, 1);
+	std::size_t wanted = std::min<std::size_t>(m_spilled, std::max(size - m_size, window));
+	bool moved = true;
+	try {
+		while (moved && wanted > 0) {
+			// Already accounted when they were spilled
+			auto result = self->Receive(m_spill_fd, wanted, false);
+			moved = result && *result > 0;
+			if (moved) {
+				wanted -= *result;
+				m_spilled -= *result;
+			}
+		}
+	} catch (...) {
+		moved = false;
+	}
+	if (!moved) {
+		self->m_error = true;
+		self->ClearSpill();
+	} else if (m_spilled == 0) {
+		self->ClearSpill();
+	} else {
+		// Let the disk work on the next window while the reader goes through this one
+		SpillFile::ReadAhead(m_spill_fd, m_spill_end - m_spilled, window);
+	}
+}
+
+std::size_t SharedFIFO::Everything(std::size_t offset) const noexcept {
+	// Memory back up to the threshold, and at least a byte past offset so the caller progresses
+	return std::max(m_spill.threshold, offset + 1);
+}
+
+bool SharedFIFO::OpenSpill() noexcept {
+	if (m_spill_fd >= 0) return true;
+	m_spill_fd = SpillFile::Open(m_spill.directory);
+	// Nowhere to spill: keep everything in memory from now on
+	if (m_spill_fd < 0) m_spill.threshold = 0;
+	return m_spill_fd >= 0;
+}
+
+void SharedFIFO::ClearSpill() noexcept {
+	if (m_spill_end > 0) SpillFile::Reset(m_spill_fd);
+	m_spill_end = 0;
+	m_spilled = 0;
+}
+
+std::shared_ptr<const LatencyHistogram> SharedFIFO::WaitHistogram() const {
+	if constexpr (!Statistics::Enabled) return nullptr;
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	if (!m_wait_histogram) m_wait_histogram = std::make_shared<LatencyHistogram>();
+	return m_wait_histogram;
+}
+
+BufferSnapshot SharedFIFO::Snapshot(std::uint64_t id) const {
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	BufferSnapshot snapshot;
+	snapshot.id = id;
+	snapshot.size = m_size + m_spliced + m_spilled;
+	snapshot.capacity = FIFO::Capacity();
+	snapshot.available = FIFO::AvailableBytes() + m_spliced + m_spilled;
+	snapshot.waiters = m_waiters;
+	snapshot.closed = m_closed;
+	snapshot.error = m_error;
+	snapshot.stats = m_stats.Snapshot();
+	return snapshot;
+}
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <StormByte/buffer/fifo.hxx>
+#include <StormByte/buffer/histogram.hxx>
+#include <StormByte/buffer/registry.hxx>
+#include <StormByte/buffer/spill.hxx>
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 
@@ -43,6 +47,23 @@ namespace StormByte::Buffer {
      *  notifies waiters so blocked readers can re-evaluate their predicates
      *  relative to the new position.
      *
+     * @par Kernel held bytes
+     *  On Linux, @ref SpliceFrom() moves bytes from a descriptor into a pipe owned by the
+     *  buffer with @c splice, and @ref SpliceTo() moves them on to another descriptor, so a
+     *  relay never copies the payload to user space. Those bytes count in Size(),
+     *  AvailableBytes() and the statistics like any other. Any call that needs the bytes
+     *  themselves (Read(), Extract(), Peek(), Seek(), a Write() after them...) first moves
+     *  them into the storage, which is the regular copying path.
+     *
+     * @par Spilling to disk
+     *  With a @ref SpillPolicy set through @ref SetSpill(), bytes written past its threshold
+     *  go to a temporary file instead of memory, so a stalled reader degrades to disk rather
+     *  than exhausting memory. They are read back in order as the reader catches up and
+     *  count in Size(), AvailableBytes() and the statistics like any other. Calls that ask
+     *  for every available byte (Read(0), Extract(0), Peek(0)) do not read the whole file
+     *  back: while bytes are spilled they get what memory holds, refilled up to the
+     *  threshold plus one SpillPolicy::read_ahead window, and callers loop until EoF().
+     *
      * @par Thread safety
      *  All public member functions of SharedFIFO are thread-safe. Methods that
      *  mutate internal state (Write/Extract/Clear/Close/Seek/Reserve) acquire
@@ -50,13 +71,20 @@ namespace StormByte::Buffer {
      *  consistency with the current head/tail/read-position state.
      */
     class STORMBYTE_BUFFER_PUBLIC SharedFIFO final: public FIFO {
+        friend class Registry;
         public:
             /**
-             * @brief Construct a SharedFIFO with optional initial capacity.
-             * @param capacity Initial number of bytes to allocate in the buffer.
-             *        Behaves like @ref FIFO and may grow as needed.
+             * @brief Construct an empty SharedFIFO.
+             * @details Registers the buffer in the @ref Registry when it is enabled.
+             */
+            SharedFIFO();
+
+            /**
+             * @brief Construct an empty SharedFIFO allocating its storage from @p resource.
+             * @param resource Memory resource for the stored bytes; must outlive the buffer.
+             * @see FIFO::FIFO(std::pmr::memory_resource*)
              */
-            SharedFIFO() noexcept = default;
+            explicit SharedFIFO(std::pmr::memory_resource* resource);
 
             SharedFIFO(const SharedFIFO&) = delete;
             SharedFIFO& operator=(const SharedFIFO&) = delete;
@@ -64,9 +92,9 @@ namespace StormByte::Buffer {
             SharedFIFO& operator=(SharedFIFO&&) = delete;
 
             /**
-             * @brief Virtual destructor.
+             * @brief Virtual destructor; unregisters the buffer from the @ref Registry.
              */
-            virtual ~SharedFIFO() = default;
+            virtual ~SharedFIFO();
 
             /**
              * @name Thread-safe overrides
@@ -91,7 +119,8 @@ namespace StormByte::Buffer {
 
 			/**
 			 * @brief Thread-safe blocking read from the buffer.
-			 * @param count Number of bytes to read; 0 reads all available immediately.
+			 * @param count Number of bytes to read; 0 reads all available immediately
+			 *              (while bytes are spilled, a bounded part: see Spilling to disk).
 			 * @return A vector containing the requested bytes, or error.
 			 * @details Blocks until @p count bytes are available from the current read position,
 			 *          or until the buffer becomes unreadable (closed or error). If count == 0,
@@ -101,9 +130,16 @@ namespace StormByte::Buffer {
 			 */
 			ExpectedData<InsufficientData> Read(std::size_t count = 0) const override;
 
+			/**
+			 * @brief Thread-safe blocking read returning data allocated from @p resource.
+			 * @see Read(std::size_t), FIFO::Read(std::size_t, std::pmr::memory_resource*)
+			 */
+			ExpectedPmrData<InsufficientData> Read(std::size_t count, std::pmr::memory_resource* resource) const override;
+
 			/**
 			 * @brief Thread-safe blocking extract from the buffer.
-			 * @param count Number of bytes to extract; 0 extracts all available immediately.
+			 * @param count Number of bytes to extract; 0 extracts all available immediately
+			 *              (while bytes are spilled, a bounded part: see Spilling to disk).
 			 * @return A vector containing the extracted bytes, or error.
 			 * @details Blocks until @p count bytes are available, or until the buffer becomes
 			 *          unreadable (closed or error). If count == 0, returns immediately with
@@ -113,10 +149,22 @@ namespace StormByte::Buffer {
 			 */
 			ExpectedData<InsufficientData> Extract(std::size_t count = 0) override;
 
+			/**
+			 * @brief Thread-safe blocking extract returning data allocated from @p resource.
+			 * @see Extract(std::size_t), FIFO::Extract(std::size_t, std::pmr::memory_resource*)
+			 */
+			ExpectedPmrData<InsufficientData> Extract(std::size_t count, std::pmr::memory_resource* resource) override;
+
+			/**
+			 * @brief Thread-safe blocking extract into a vector with inline capacity.
+			 * @see Extract(std::size_t), FIFO::ExtractSmall()
+			 */
+			ExpectedSmallData<InsufficientData> ExtractSmall(std::size_t count = 0) override;
+
 			/**
 			 * @brief Thread-safe write to the buffer.
 			 * @param data Byte vector to append to the FIFO.
-			 * @return true if written, false if closed.
+			 * @return true if written, false if closed or the bytes could not be spilled.
 			 * @details Thread-safe version that notifies waiting readers after write.
 			 * @see FIFO::Write()
 			 */
@@ -125,12 +173,18 @@ namespace StormByte::Buffer {
 			/**
 			 * @brief Thread-safe write to the buffer.
 			 * @param data String to append to the FIFO.
-			 * @return true if written, false if closed.
+			 * @return true if written, false if closed or the bytes could not be spilled.
 			 * @details Thread-safe version that notifies waiting readers after write.
 			 * @see FIFO::Write()
 			 */
 			bool Write(const std::string& data) override;
 
+			/**
+			 * @brief Thread-safe write of any contiguous bytes.
+			 * @see FIFO::Write(std::span<const std::byte>)
+			 */
+			bool Write(std::span<const std::byte> data) override;
+
 			/**
 			 * @brief Thread-safe clear of all buffer contents.
 			 * @see FIFO::Clear()
@@ -143,14 +197,198 @@ namespace StormByte::Buffer {
 			 */
 			void Clean() noexcept override;
 
+			/**
+			 * @brief Thread-safe reserve.
+			 * @see FIFO::Reserve()
+			 */
+			void Reserve(std::size_t bytes) override;
+
+			/**
+			 * @brief Thread-safe release of spare storage.
+			 * @see FIFO::ShrinkToFit()
+			 */
+			void ShrinkToFit() override;
+
+			/**
+			 * @brief Thread-safe retention policy update.
+			 * @see FIFO::SetRetention()
+			 */
+			void SetRetention(const RetentionPolicy& policy) noexcept override;
+
+			/**
+			 * @brief Thread-safe retention policy query.
+			 * @see FIFO::Retention()
+			 */
+			RetentionPolicy Retention() const noexcept override;
+
+			/**
+			 * @brief Thread-safe storage change.
+			 * @see FIFO::SetStorage()
+			 */
+			void SetStorage(const StorageOptions& options) override;
+
+			/**
+			 * @brief Thread-safe storage options query.
+			 * @see FIFO::Storage()
+			 */
+			StorageOptions Storage() const noexcept override;
+
+			/**
+			 * @brief Contiguous view of stored bytes, taken under the lock; does not block.
+			 * @warning The span is only safe to use while no other thread writes to or
+			 *          consumes from the buffer, e.g. a single reader over reserved storage
+			 *          that writers never outgrow.
+			 * @see FIFO::Peek()
+			 */
+			std::span<const std::byte> Peek(std::size_t count = 0) override;
+
+			/**
+			 * @brief Contiguous writable space, taken under the lock.
+			 * @warning Same restrictions on the span as Peek().
+			 * @see FIFO::Acquire()
+			 */
+			std::span<std::byte> Acquire(std::size_t count) override;
+
+			/**
+			 * @brief Thread-safe commit of acquired bytes.
+			 * @details Notifies waiting readers.
+			 * @see FIFO::Commit()
+			 */
+			bool Commit(std::size_t count) override;
+
+			/**
+			 * @brief Thread-safe read from a file descriptor into the buffer.
+			 * @details Waits for @p fd to become readable without holding the lock, then
+			 *          reads under it and notifies waiting readers. Meant for one thread
+			 *          reading a given descriptor.
+			 * @see FIFO::ReadFrom()
+			 */
+			Expected<std::size_t, IOError> ReadFrom(int fd, std::size_t count = 0) override;
+
+			/**
+			 * @brief Thread-safe write of stored bytes to a file descriptor.
+			 * @details Blocks until at least one byte is stored or the buffer is closed, so
+			 *          0 means closed and drained. Writes do not block under the lock
+			 *          (@c RWF_NOWAIT): while @p fd has no room the lock is released and the
+			 *          call waits for it with @c poll, so a stalled peer does not hold back
+			 *          the other users of the buffer. Descriptors that cannot write without
+			 *          blocking (regular files, ttys, kernels before 4.14) are handled once
+			 *          they report room: files and block devices, which only wait for the
+			 *          disk, get a plain @c writev; any other gets up to 64 KiB taken out of
+			 *          the buffer and written without the lock, and loses them if it fails.
+			 * @see FIFO::WriteTo()
+			 */
+			Expected<std::size_t, IOError> WriteTo(int fd, std::size_t count = 0) override;
+
+			/**
+			 * @brief Thread-safe replacement of the content with a mapped file.
+			 * @details Drops the bytes held in the kernel pipe as well, and wakes waiting
+			 *          readers: the buffer is closed afterwards.
+			 * @warning Same as FIFO::MapFile(): truncating the file while mapped raises SIGBUS.
+			 * @see FIFO::MapFile(), Consumer::MapFile()
+			 */
+			Expected<std::size_t, IOError> MapFile(const std::filesystem::path& path) override;
+
+			/**
+			 * @brief Move bytes from a descriptor into the buffer without copying them to user space.
+			 * @param fd Descriptor to read (socket, pipe, file...).
+			 * @param count Most bytes to move; 0 moves up to the free room of the kernel pipe.
+			 * @return Bytes moved, 0 at end of file, or IOError as ReadFrom().
+			 * @details Waits for @p fd without holding the lock, then @c splice()s into the
+			 *          buffer's pipe and notifies waiting readers. When the pipe is full its
+			 *          bytes are first moved into the storage. Where @c splice is unavailable
+			 *          (other platforms, descriptors that do not support it) this is ReadFrom().
+			 * @see SpliceTo(), Producer::SpliceFrom(), SpliceSource()
+			 */
+			Expected<std::size_t, IOError> SpliceFrom(int fd, std::size_t count = 0);
+
+			/**
+			 * @brief Move buffered bytes to a descriptor, and remove them, without copying them to user space.
+			 * @param fd Descriptor to write.
+			 * @param count Most bytes to move; 0 moves all that can go in one call.
+			 * @return Bytes moved, 0 once the buffer is closed and drained, or IOError as WriteTo().
+			 * @details Waits for bytes like WriteTo(). Bytes in the storage go first, with
+			 *          WriteTo(); bytes held in the kernel pipe are then moved out of the buffer
+			 *          under the lock, through a per-thread pipe, and @c splice()d to @p fd
+			 *          without it, so a full @p fd never holds back the other users. Bytes
+			 *          taken out are lost if @p fd then fails; a descriptor that does not take
+			 *          splices gets them copied.
+			 * @see SpliceFrom(), Consumer::SpliceTo(), SpliceSink()
+			 */
+			Expected<std::size_t, IOError> SpliceTo(int fd, std::size_t count = 0);
+
+			/**
+			 * @brief Choose when unread bytes move to disk.
+			 * @param policy Spill policy; a zero threshold stops spilling new bytes. Bytes
+			 *               already on disk are still read back in order.
+			 * @details Dropped (threshold reset to 0) on platforms without support, and once
+			 *          the file cannot be created, so Spill() reports what is in effect. When
+			 *          the disk fills up, bytes stay in memory until the file holds none, and
+			 *          a write that can keep neither order nor bytes is refused and puts the
+			 *          buffer in error.
+			 * @see SpillPolicy, Pipeline::SetSpill()
+			 */
+			void SetSpill(const SpillPolicy& policy);
+
+			/**
+			 * @brief Spill policy in effect.
+			 * @see SetSpill()
+			 */
+			SpillPolicy Spill() const;
+
+			/**
+			 * @brief Bytes currently held in the spill file, included in Size().
+			 * @see SetSpill()
+			 */
+			std::size_t SpilledBytes() const noexcept;
+
 			/**
 			 * @brief Thread-safe seek operation.
 			 * @details Notifies waiting readers after seeking.
 			 * @see FIFO::Seek()
 			 */
 			void Seek(const std::ptrdiff_t& offset, const Position& mode) const noexcept override;
+
+			/**
+			 * @brief Thread-safe snapshot of the usage counters.
+			 * @see FIFO::Stats()
+			 */
+			Statistics Stats() const noexcept override;
+
+			/**
+			 * @brief Thread-safe storage capacity.
+			 * @see FIFO::Capacity()
+			 */
+			std::size_t Capacity() const noexcept override;
+
+			/**
+			 * @brief Bytes available from the read position, including bytes held by the kernel.
+			 * @see FIFO::AvailableBytes(), SpliceFrom()
+			 */
+			std::size_t AvailableBytes() const noexcept override;
+
+			/**
+			 * @brief Bytes stored, including bytes held by the kernel.
+			 * @see FIFO::Size(), SpliceFrom()
+			 */
+			std::size_t Size() const noexcept override;
+
+			/**
+			 * @brief Check if no bytes are stored, including bytes held by the kernel.
+			 * @see FIFO::Empty()
+			 */
+			bool Empty() const noexcept override;
             /** @} */
 
+			/**
+			 * @brief Histogram of the time readers spent blocked in @ref Read() / @ref Extract().
+			 * @return Shared handle to the live histogram (created on first use), or nullptr
+			 *         when statistics are disabled at build time.
+			 * @details Only waits that actually blocked are recorded. The handle stays valid
+			 *          after the buffer is destroyed.
+			 */
+			std::shared_ptr<const LatencyHistogram> WaitHistogram() const;
+
         private:
             /**
              * @brief Wait until at least @p n bytes are available from the current read position
@@ -164,9 +402,127 @@ namespace StormByte::Buffer {
              */
             void Wait(std::size_t n, std::unique_lock<std::mutex>& lock) const;
 
+            /**
+             * @brief Block for a Read() of @p count bytes.
+             * @return Byte count to pass to FIFO::Read(): @p count, or 0 (all available)
+             *         when the buffer was closed before enough data arrived.
+             */
+            std::size_t WaitForRead(std::size_t count, std::unique_lock<std::mutex>& lock) const;
+
+            /**
+             * @brief Block for an Extract() of @p count bytes.
+             * @return Byte count to pass to FIFO::Extract(), as for WaitForRead().
+             */
+            std::size_t WaitForExtract(std::size_t count, std::unique_lock<std::mutex>& lock) const;
+
+            /**
+             * @brief Append bytes under the lock and notify waiters.
+             * @param data Pointer to the first byte to append.
+             * @param size Number of bytes to append.
+             * @return true if written, false if closed, @p size is 0 or the bytes could
+             *         not be spilled (the buffer is then in error).
+             */
+            bool WriteBytes(const std::byte* data, std::size_t size);
+
+            /**
+             * @brief Take a bounded chunk out of the storage and write it to @p fd without the lock.
+             * @param lock Held on entry, released before writing.
+             * @return Bytes written, or IOError when the write fails (the chunk is lost).
+             * @details WriteTo() path for descriptors that may wait for a peer yet cannot
+             *          write without blocking.
+             */
+            Expected<std::size_t, IOError> Handoff(int fd, std::size_t count, std::unique_lock<std::mutex>& lock);
+
+            /**
+             * @brief Move the bytes held in the kernel pipe to the end of the storage.
+             * @details Called under the lock before any access to the bytes themselves. When
+             *          they cannot be taken back (no memory), the buffer goes into error state
+             *          rather than reorder or lose them. No-op without kernel held bytes.
+             */
+            void Drain() const noexcept;
+
+            /**
+             * @brief Append bytes, spilling what goes past the threshold straight to the file.
+             * @details Called under the lock in place of Append(). Accounts for the bytes.
+             * @return false when bytes that belong behind spilled ones cannot be written to
+             *         the file: they are dropped and the buffer goes into error.
+             */
+            bool Store(const std::byte* data, std::size_t size);
+
+            /**
+             * @brief Spill the last @p appended stored bytes as the spill policy requires.
+             * @details Called under the lock after bytes were placed in the storage by
+             *          Commit() or ReadFrom(): they go after the spilled ones, or past the
+             *          threshold. No-op while not spilling.
+             */
+            void Overflow(std::size_t appended) noexcept;
+
+            /**
+             * @brief Read spilled bytes back until @p size bytes are stored or none are spilled.
+             * @details Called under the lock before any access to the bytes themselves. Reads
+             *          at least a SpillPolicy::read_ahead window and asks the kernel for the
+             *          next one. A failed read puts the buffer in error, as Drain() does.
+             */
+            void Refill(std::size_t size) const noexcept;
+
+            /**
+             * @brief Refill() target for a call asking for every byte available past @p offset.
+             * @details Bounds what such calls bring back from the spill file to the threshold
+             *          plus one window, instead of the whole file.
+             */
+            std::size_t Everything(std::size_t offset) const noexcept;
+
+            /**
+             * @brief Create the spill file on first use.
+             * @return Whether the file exists; when it cannot be created spilling is turned off.
+             */
+            bool OpenSpill() noexcept;
+
+            /**
+             * @brief Drop the spilled bytes.
+             */
+            void ClearSpill() noexcept;
+
+            /**
+             * @brief Create the kernel pipe on first use.
+             * @return Whether the pipe exists.
+             */
+            bool OpenPipe() noexcept;
+
+            /**
+             * @brief Close the kernel pipe, dropping what it holds.
+             */
+            void ClosePipe() noexcept;
+
+            /**
+             * @brief Consistent view of the buffer state for the @ref Registry.
+             * @param id Registry id to report.
+             */
+            BufferSnapshot Snapshot(std::uint64_t id) const;
+
             /** @brief Internal mutex guarding all state mutations and reads. */
             mutable std::mutex m_mutex;
             /** @brief Condition variable used to block until data is available or closed. */
             mutable std::condition_variable_any m_cv;
+            /** @brief Number of threads currently blocked in Wait() (guarded by m_mutex). */
+            mutable std::size_t m_waiters = 0;
+            /** @brief Blocked read latencies, allocated on the first wait (guarded by m_mutex). */
+            mutable std::shared_ptr<LatencyHistogram> m_wait_histogram;
+            /** @brief Whether this buffer is listed in the Registry. */
+            bool m_registered = false;
+            /** @brief Kernel pipe behind SpliceFrom() (read end, write end); -1 until first used. */
+            int m_pipe[2] = { -1, -1 };
+            /** @brief Bytes the kernel pipe can hold. */
+            std::size_t m_pipe_capacity = 0;
+            /** @brief Bytes held in the kernel pipe, after the stored ones (written under m_mutex). */
+            mutable std::atomic<std::size_t> m_spliced { 0 };
+            /** @brief When bytes go to the spill file. */
+            SpillPolicy m_spill;
+            /** @brief Spill file; -1 until first needed. */
+            int m_spill_fd = -1;
+            /** @brief Offset in the spill file of the next spilled byte. */
+            std::uint64_t m_spill_end = 0;
+            /** @brief Bytes held in the spill file, after the stored ones (written under m_mutex). */
+            mutable std::atomic<std::size_t> m_spilled { 0 };
     };
 }
@@ -0,0 +1,191 @@
+#include <StormByte/buffer/slab_pool.hxx>
+
+#include <algorithm>
+#include <bit>
+
+using namespace StormByte::Buffer;
+
+namespace {
+	constexpr std::size_t min_shift = std::countr_zero(SlabPool::MinBlock);
+	constexpr std::size_t slab_bytes = 256 * 1024;				// Slab size, at least 4 blocks of the largest class
+
+	constexpr std::size_t classIndex(std::size_t block) noexcept {
+		return static_cast<std::size_t>(std::countr_zero(block)) - min_shift;
+	}
+
+	constexpr std::size_t classBlock(std::size_t index) noexcept {
+		return SlabPool::MinBlock << index;
+	}
+
+	// Blocks a magazine holds before half of them go back to the depot
+	constexpr std::size_t magazineCapacity(std::size_t index) noexcept {
+		return std::clamp<std::size_t>(64 * 1024 / classBlock(index), 4, 128);
+	}
+
+	void raiseMax(std::atomic<std::size_t>& max, std::size_t value) noexcept {
+		std::size_t current = max.load(std::memory_order_relaxed);
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+	}
+}
+
+struct SlabPool::ThreadCache {
+	SlabPool& pool;
+	std::array<std::vector<void*>, ClassCount> magazines;
+	// Only written by the owning thread; atomics so Stats() can read them concurrently
+	std::atomic<std::size_t> allocations { 0 };
+	std::atomic<std::size_t> hits { 0 };
+	std::atomic<std::size_t> refills { 0 };
+
+	explicit ThreadCache(SlabPool& owner): pool(owner) {
+		for (std::size_t i = 0; i < ClassCount; ++i) magazines[i].reserve(magazineCapacity(i));
+		std::scoped_lock<std::mutex> lock(pool.m_mutex);
+		pool.m_caches.push_back(this);
+	}
+
+	~ThreadCache();
+};
+
+namespace {
+	// Trivially destructible, so it stays readable while other thread_locals are destroyed
+	thread_local bool cache_destroyed = false;
+}
+
+SlabPool::ThreadCache::~ThreadCache() {
+	for (std::size_t i = 0; i < ClassCount; ++i)
+		pool.Flush(i, magazines[i], magazines[i].size());
+	std::scoped_lock<std::mutex> lock(pool.m_mutex);
+	pool.m_retired.allocations += allocations.load(std::memory_order_relaxed);
+	pool.m_retired.hits += hits.load(std::memory_order_relaxed);
+	pool.m_retired.refills += refills.load(std::memory_order_relaxed);
+	pool.m_caches.erase(std::find(pool.m_caches.begin(), pool.m_caches.end(), this));
+	cache_destroyed = true;
+}
+
+SlabPool& SlabPool::Instance() {
+	// Leaked on purpose: thread magazines flush into it at thread exit, possibly after static destruction
+	static SlabPool* instance = new SlabPool();
+	return *instance;
+}
+
+SlabPoolStats SlabPool::Stats() const {
+	SlabPoolStats stats;
+	{
+		std::scoped_lock<std::mutex> lock(m_mutex);
+		stats = m_retired;
+		for (const ThreadCache* cache : m_caches) {
+			stats.allocations += cache->allocations.load(std::memory_order_relaxed);
+			stats.hits += cache->hits.load(std::memory_order_relaxed);
+			stats.refills += cache->refills.load(std::memory_order_relaxed);
+		}
+	}
+	stats.large_allocations = m_large.load(std::memory_order_relaxed);
+	stats.reserved_bytes = m_reserved.load(std::memory_order_relaxed);
+	stats.outstanding_bytes = m_outstanding.load(std::memory_order_relaxed);
+	stats.high_water_bytes = m_high_water.load(std::memory_order_relaxed);
+	return stats;
+}
+
+std::size_t SlabPool::BlockSize(std::size_t bytes, std::size_t alignment) noexcept {
+	if (bytes > MaxBlock || alignment > BlockAlignment) return 0;
+	return std::max(MinBlock, std::bit_ceil(std::max<std::size_t>(bytes, 1)));
+}
+
+void* SlabPool::do_allocate(std::size_t bytes, std::size_t alignment) {
+	const std::size_t block = BlockSize(bytes, alignment);
+	if (block == 0) {
+		m_large.fetch_add(1, std::memory_order_relaxed);
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	const std::size_t index = classIndex(block);
+	ThreadCache* cache = LocalCache();
+	if (!cache) {
+		// Thread is exiting: go through the depot directly
+		std::vector<void*> single;
+		Refill(index, single, 1);
+		return single.back();
+	}
+
+	auto& magazine = cache->magazines[index];
+	cache->allocations.store(cache->allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	if (!magazine.empty()) {
+		cache->hits.store(cache->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	else {
+		cache->refills.store(cache->refills.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		Refill(index, magazine, magazineCapacity(index) / 2);
+	}
+	void* p = magazine.back();
+	magazine.pop_back();
+	return p;
+}
+
+void SlabPool::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+	const std::size_t block = BlockSize(bytes, alignment);
+	if (block == 0) {
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		return;
+	}
+	const std::size_t index = classIndex(block);
+	ThreadCache* cache = LocalCache();
+	if (!cache) {
+		std::vector<void*> single { p };
+		Flush(index, single, 1);
+		return;
+	}
+
+	auto& magazine = cache->magazines[index];
+	const std::size_t capacity = magazineCapacity(index);
+	if (magazine.size() >= capacity)
+		Flush(index, magazine, capacity / 2);
+	magazine.push_back(p);
+}
+
+bool SlabPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+SlabPool::ThreadCache* SlabPool::LocalCache() {
+	if (cache_destroyed) return nullptr;
+	thread_local ThreadCache cache(*this);
+	return &cache;
+}
+
+void SlabPool::Refill(std::size_t index, std::vector<void*>& out, std::size_t count) {
+	const std::size_t block = classBlock(index);
+	Depot& depot = m_depots[index];
+	std::scoped_lock<std::mutex> lock(depot.mutex);
+	if (depot.free.empty()) {
+		void* slab = std::pmr::new_delete_resource()->allocate(slab_bytes, BlockAlignment);
+		{
+			std::scoped_lock<std::mutex> slabs_lock(m_mutex);
+			m_slabs.push_back(slab);
+		}
+		m_reserved.fetch_add(slab_bytes, std::memory_order_relaxed);
+		auto* bytes = static_cast<std::byte*>(slab);
+		// Pushed in reverse so blocks are handed out in address order
+		for (std::size_t offset = slab_bytes; offset >= block; offset -= block)
+			depot.free.push_back(bytes + offset - block);
+	}
+	const std::size_t moved = std::min(count, depot.free.size());
+	out.insert(out.end(), depot.free.end() - static_cast<std::ptrdiff_t>(moved), depot.free.end());
+	depot.free.resize(depot.free.size() - moved);
+	const std::size_t outstanding = m_outstanding.fetch_add(moved * block, std::memory_order_relaxed) + moved * block;
+	raiseMax(m_high_water, outstanding);
+}
+
+void SlabPool::Flush(std::size_t index, std::vector<void*>& blocks, std::size_t count) noexcept {
+	const std::size_t moved = std::min(count, blocks.size());
+	if (moved == 0) return;
+	Depot& depot = m_depots[index];
+	{
+		std::scoped_lock<std::mutex> lock(depot.mutex);
+		try {
+			depot.free.insert(depot.free.end(), blocks.end() - static_cast<std::ptrdiff_t>(moved), blocks.end());
+		}
+		catch (...) {
+			// Could not grow the free list: the blocks stay out of the pool (leaked, never reused)
+		}
+	}
+	blocks.resize(blocks.size() - moved);
+	m_outstanding.fetch_sub(moved * classBlock(index), std::memory_order_relaxed);
+}
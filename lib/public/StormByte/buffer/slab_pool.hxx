@@ -0,0 +1,135 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @struct SlabPoolStats
+	 * @brief Counters of the process wide @ref SlabPool.
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC SlabPoolStats {
+		std::size_t allocations			= 0;	///< Requests served by a size class
+		std::size_t hits				= 0;	///< Requests served from the calling thread's magazine
+		std::size_t refills				= 0;	///< Magazine refills from the central depot (each takes its lock)
+		std::size_t large_allocations	= 0;	///< Requests passed straight to the upstream resource
+		std::size_t reserved_bytes		= 0;	///< Slab memory obtained from upstream (kept for reuse)
+		std::size_t outstanding_bytes	= 0;	///< Bytes out of the depot: in use or cached by threads
+		std::size_t high_water_bytes	= 0;	///< Peak of outstanding_bytes
+
+		/**
+		 * @brief Fraction of size class requests served without touching the depot.
+		 */
+		inline double HitRate() const noexcept {
+			return allocations > 0 ? static_cast<double>(hits) / static_cast<double>(allocations) : 0.0;
+		}
+	};
+
+	/**
+	 * @class SlabPool
+	 * @brief Process wide, thread caching pool of fixed size blocks.
+	 *
+	 * @par Overview
+	 *  A @c std::pmr::memory_resource serving requests of up to @ref MaxBlock bytes from
+	 *  power of two size classes (64 B to 64 KiB). Blocks are carved from large slabs
+	 *  obtained from @c std::pmr::new_delete_resource() and are never returned to it;
+	 *  they are recycled instead. Larger or over aligned requests go straight upstream.
+	 *
+	 * @par Magazines
+	 *  Every thread keeps a small stack (magazine) of free blocks per size class, so most
+	 *  allocations and deallocations are a pointer pop/push without any lock or atomic
+	 *  read-modify-write. An empty magazine is refilled with half a magazine from the
+	 *  central depot of its class, and a full one returns half of its blocks. A
+	 *  thread's magazines are flushed back to the depot when it exits, so short lived
+	 *  Pipeline stage threads do not strand memory.
+	 *
+	 * @par Usage
+	 *  Pass @ref Instance() to any buffer, Producer or Pipeline constructor, or install it
+	 *  process wide with @c std::pmr::set_default_resource(&SlabPool::Instance()) so
+	 *  default constructed buffers draw from it too.
+	 */
+	class STORMBYTE_BUFFER_PUBLIC SlabPool final: public std::pmr::memory_resource {
+		public:
+			static constexpr std::size_t MinBlock		= 64;				///< Smallest size class
+			static constexpr std::size_t MaxBlock		= 64 * 1024;		///< Largest size class
+			static constexpr std::size_t ClassCount		= 11;				///< Number of size classes
+			static constexpr std::size_t BlockAlignment	= 64;				///< Alignment of every pooled block
+
+			SlabPool(const SlabPool&) = delete;
+			SlabPool(SlabPool&&) = delete;
+			SlabPool& operator=(const SlabPool&) = delete;
+			SlabPool& operator=(SlabPool&&) = delete;
+
+			/**
+			 * @brief The process wide pool.
+			 */
+			static SlabPool& 										Instance();
+
+			/**
+			 * @brief Snapshot of the pool counters, including live thread magazines.
+			 */
+			SlabPoolStats 											Stats() const;
+
+			/**
+			 * @brief Size class (block size) that serves a request of @p bytes.
+			 * @return Block size in bytes, or 0 when the request is not pooled.
+			 */
+			static std::size_t 										BlockSize(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+		private:
+			struct ThreadCache;
+			friend struct ThreadCache;
+
+			/** @brief Central free list of one size class. */
+			struct Depot {
+				std::mutex mutex;									///< Guards free
+				std::vector<void*> free;							///< Free blocks
+			};
+
+			std::array<Depot, ClassCount> m_depots;					///< One depot per size class
+			mutable std::mutex m_mutex;								///< Guards m_slabs, m_caches and m_retired
+			std::vector<void*> m_slabs;								///< Every slab obtained from upstream
+			std::vector<const ThreadCache*> m_caches;				///< Live thread magazines (for Stats())
+			SlabPoolStats m_retired;								///< Counters of exited threads
+			std::atomic<std::size_t> m_large { 0 };					///< Requests passed upstream
+			std::atomic<std::size_t> m_reserved { 0 };				///< Bytes of all slabs
+			std::atomic<std::size_t> m_outstanding { 0 };			///< Bytes out of the depots
+			std::atomic<std::size_t> m_high_water { 0 };			///< Peak of m_outstanding
+
+			SlabPool() noexcept = default;
+			~SlabPool() override = default;
+
+			void* 													do_allocate(std::size_t bytes, std::size_t alignment) override;
+			void 													do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+			bool 													do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+			/**
+			 * @brief Calling thread's magazines, or nullptr once they were destroyed at thread exit.
+			 */
+			ThreadCache* 											LocalCache();
+
+			/**
+			 * @brief Move up to @p count free blocks of class @p index into @p out, carving a new slab if needed.
+			 */
+			void 													Refill(std::size_t index, std::vector<void*>& out, std::size_t count);
+
+			/**
+			 * @brief Return the last @p count blocks of @p blocks to the depot of class @p index.
+			 */
+			void 													Flush(std::size_t index, std::vector<void*>& blocks, std::size_t count) noexcept;
+	};
+}
@@ -0,0 +1,40 @@
+#include <StormByte/buffer/small_bytes.hxx>
+
+#include <utility>
+
+using namespace StormByte::Buffer;
+
+SmallBytes::SmallBytes(std::span<const std::byte> bytes) {
+	insert(end(), bytes.begin(), bytes.end());
+}
+
+SmallBytes::SmallBytes(const SmallBytes& other) {
+	insert(end(), other.begin(), other.end());
+}
+
+SmallBytes& SmallBytes::operator=(const SmallBytes& other) {
+	if (this != &other) {
+		clear();
+		insert(end(), other.begin(), other.end());
+	}
+	return *this;
+}
+
+SmallBytes& SmallBytes::operator=(SmallBytes&& other) noexcept {
+	if (this != &other) {
+		delete[] m_heap;
+		m_heap = std::exchange(other.m_heap, nullptr);
+		m_capacity = std::exchange(other.m_capacity, 0);
+		m_size = std::exchange(other.m_size, 0);
+		if (!m_heap) std::memcpy(m_inline, other.m_inline, m_size);
+	}
+	return *this;
+}
+
+void SmallBytes::Grow(std::size_t capacity) {
+	std::byte* heap = new std::byte[capacity];
+	std::memcpy(heap, data(), m_size);
+	delete[] m_heap;
+	m_heap = heap;
+	m_capacity = capacity;
+}
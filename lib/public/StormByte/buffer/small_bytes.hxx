@@ -0,0 +1,119 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @class SmallBytes
+	 * @brief Byte vector with inline capacity for small messages.
+	 *
+	 * @details Holds up to @ref InlineCapacity bytes inside the object and only falls back
+	 *          to the heap beyond that, so extracting a tiny message does not allocate.
+	 *          Offers the subset of the @c std::vector interface needed to read and build
+	 *          byte messages, and converts to @c std::span.
+	 * @see FIFO::ExtractSmall()
+	 */
+	class STORMBYTE_BUFFER_PUBLIC SmallBytes final {
+		public:
+			static constexpr std::size_t InlineCapacity = 64;		///< Bytes stored without allocating
+
+			using value_type		= std::byte;
+			using size_type			= std::size_t;
+			using iterator			= std::byte*;
+			using const_iterator	= const std::byte*;
+
+			/**
+			 * @brief Construct an empty buffer using the inline storage.
+			 */
+			SmallBytes() noexcept									= default;
+
+			/**
+			 * @brief Construct holding a copy of @p bytes.
+			 */
+			explicit SmallBytes(std::span<const std::byte> bytes);
+
+			SmallBytes(const SmallBytes& other);
+			inline SmallBytes(SmallBytes&& other) noexcept: m_heap(std::exchange(other.m_heap, nullptr)),
+			m_capacity(std::exchange(other.m_capacity, 0)), m_size(std::exchange(other.m_size, 0)) {
+				if (!m_heap) std::memcpy(m_inline, other.m_inline, m_size);
+			}
+			SmallBytes& operator=(const SmallBytes& other);
+			SmallBytes& operator=(SmallBytes&& other) noexcept;
+			inline ~SmallBytes() noexcept { delete[] m_heap; }
+
+			inline std::byte* 										data() noexcept { return m_heap ? m_heap : m_inline; }
+			inline const std::byte* 								data() const noexcept { return m_heap ? m_heap : m_inline; }
+			inline std::size_t 										size() const noexcept { return m_size; }
+			inline std::size_t 										capacity() const noexcept { return m_heap ? m_capacity : InlineCapacity; }
+			inline bool 											empty() const noexcept { return m_size == 0; }
+			inline iterator 										begin() noexcept { return data(); }
+			inline iterator 										end() noexcept { return data() + m_size; }
+			inline const_iterator 									begin() const noexcept { return data(); }
+			inline const_iterator 									end() const noexcept { return data() + m_size; }
+			inline std::byte& 										operator[](std::size_t index) noexcept { return data()[index]; }
+			inline const std::byte& 								operator[](std::size_t index) const noexcept { return data()[index]; }
+			inline 													operator std::span<const std::byte>() const noexcept { return { data(), m_size }; }
+
+			/**
+			 * @brief Whether the content still lives in the inline storage.
+			 */
+			inline bool 											IsInline() const noexcept { return m_heap == nullptr; }
+
+			/**
+			 * @brief Make room for @p capacity bytes.
+			 */
+			inline void 											reserve(std::size_t capacity) { if (capacity > this->capacity()) Grow(capacity); }
+
+			/**
+			 * @brief Remove all bytes, keeping the capacity.
+			 */
+			inline void 											clear() noexcept { m_size = 0; }
+
+			/**
+			 * @brief Insert the bytes of [first, last) before @p position.
+			 * @return Iterator to the first inserted byte.
+			 */
+			template<class InputIterator>
+			iterator 												insert(const_iterator position, InputIterator first, InputIterator last) {
+				const std::size_t index = static_cast<std::size_t>(position - data());
+				const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+				if (m_size + count > capacity()) Grow(std::max(m_size + count, 2 * capacity()));
+				std::byte* at = data() + index;
+				std::memmove(at + count, at, m_size - index);
+				if constexpr (std::contiguous_iterator<InputIterator>) {
+					if (count > 0) std::memcpy(at, std::to_address(first), count);
+				} else {
+					for (std::byte* out = at; first != last; ++first, ++out) *out = static_cast<std::byte>(*first);
+				}
+				m_size += count;
+				return at;
+			}
+
+		private:
+			std::byte m_inline[InlineCapacity];						///< Inline storage, used while m_heap is null
+			std::byte* m_heap = nullptr;							///< Heap storage once grown past InlineCapacity
+			std::size_t m_capacity = 0;								///< Size of m_heap
+			std::size_t m_size = 0;									///< Stored bytes
+
+			/**
+			 * @brief Move the content to heap storage of @p capacity bytes.
+			 */
+			void 													Grow(std::size_t capacity);
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <cstddef>
+#include <filesystem>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @struct SpillPolicy
+	 * @brief When a SharedFIFO moves unread bytes to disk instead of growing in memory.
+	 *
+	 * @details Once @ref threshold bytes are stored in memory, further bytes go to an
+	 *          unlinked temporary file, behind the ones in memory. As the reader consumes
+	 *          the bytes in memory they are read back from the file sequentially, a
+	 *          @ref read_ahead window at a time, with the kernel asked to prefetch the next
+	 *          window. Readers see the same bytes in the same order: Size(),
+	 *          AvailableBytes(), EoF() and the statistics count spilled bytes as stored.
+	 *          Memory stays bounded for readers too: Read(0), Extract(0) and Peek(0) bring
+	 *          back at most @ref threshold bytes plus one window, so they return part of
+	 *          what is available. Below the threshold the buffer never touches the file.
+	 * @see SharedFIFO::SetSpill(), Pipeline::SetSpill()
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC SpillPolicy {
+		std::size_t threshold		= 0;				///< Bytes kept in memory before spilling; 0 never spills
+		std::size_t read_ahead		= 1024 * 1024;		///< Bytes read back from the file at once
+		std::filesystem::path directory;				///< Where the file is created; empty for the system temporary directory
+
+		bool operator==(const SpillPolicy&) const = default;
+	};
+}
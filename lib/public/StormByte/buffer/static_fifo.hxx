@@ -0,0 +1,309 @@
+#pragma once
+
+#include <StormByte/buffer/position.hxx>
+#include <StormByte/buffer/typedefs.hxx>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @class StaticFIFO
+	 * @brief Fixed capacity byte FIFO with inline storage.
+	 * @tparam N Capacity in bytes; index wrap is a mask when it is a power of two.
+	 *
+	 * @par Overview
+	 *  A ring buffer of @p N bytes stored inside the object, so it never touches the heap
+	 *  on its own: put it on the stack or inside a per-connection struct. It follows the
+	 *  @ref FIFO semantics for Write(), Read(), Extract() and Seek(), except that a write
+	 *  that does not fit is rejected with @ref BufferOverflow instead of growing.
+	 *
+	 * @par Heap free reads
+	 *  Read() and Extract() taking a @c std::span copy into caller storage. The overloads
+	 *  taking a count return a @c std::vector like FIFO does, which allocates.
+	 *
+	 * @par constexpr
+	 *  Every member is @c constexpr, so framing logic can be exercised at compile time.
+	 *  For that reason the read position is not @c mutable, and unlike FIFO, Read() and
+	 *  Seek() are non-const.
+	 *
+	 * @par Thread safety
+	 *  This class is **not thread-safe**.
+	 *
+	 * @see FIFO
+	 */
+	template<std::size_t N>
+	class StaticFIFO final {
+		static_assert(N > 0, "StaticFIFO capacity must not be zero");
+
+		public:
+			/**
+			 * @brief Construct an empty FIFO; the storage is left uninitialized.
+			 */
+			constexpr StaticFIFO() noexcept											= default;
+
+			/**
+			 * @brief Capacity in bytes.
+			 */
+			static constexpr std::size_t 											Capacity() noexcept { return N; }
+
+			/**
+			 * @brief Number of stored bytes.
+			 * @see FIFO::Size()
+			 */
+			constexpr std::size_t 													Size() const noexcept { return m_size; }
+
+			/**
+			 * @brief Number of bytes that can still be written.
+			 */
+			constexpr std::size_t 													FreeBytes() const noexcept { return N - m_size; }
+
+			/**
+			 * @brief Number of bytes readable from the current read position.
+			 * @see FIFO::AvailableBytes()
+			 */
+			constexpr std::size_t 													AvailableBytes() const noexcept {
+				return m_position_offset <= m_size ? m_size - m_position_offset : 0;
+			}
+
+			/**
+			 * @brief Check if the buffer holds no data.
+			 */
+			constexpr bool 															Empty() const noexcept { return m_size == 0; }
+
+			/**
+			 * @brief Check if no more bytes can be written.
+			 */
+			constexpr bool 															Full() const noexcept { return m_size == N; }
+
+			/**
+			 * @brief Remove all data and reset the read position.
+			 * @see FIFO::Clear()
+			 */
+			constexpr void 															Clear() noexcept {
+				m_head = 0;
+				m_size = 0;
+				m_position_offset = 0;
+			}
+
+			/**
+			 * @brief Remove data from the start up to the read position.
+			 * @see FIFO::Clean()
+			 */
+			constexpr void 															Clean() noexcept {
+				if (m_position_offset > 0 && m_position_offset <= m_size) {
+					Drop(m_position_offset);
+					m_position_offset = 0;
+				}
+			}
+
+			/**
+			 * @brief Close the FIFO for further writes.
+			 * @see FIFO::Close()
+			 */
+			constexpr void 															Close() noexcept { m_closed = true; }
+
+			/**
+			 * @brief Mark the buffer as erroneous, making it unreadable and unwritable.
+			 * @see FIFO::SetError()
+			 */
+			constexpr void 															SetError() noexcept { m_error = true; }
+
+			/**
+			 * @brief Check if the buffer is readable (not in error state).
+			 */
+			constexpr bool 															IsReadable() const noexcept { return !m_error; }
+
+			/**
+			 * @brief Check if the buffer is writable (not closed and not in error state).
+			 */
+			constexpr bool 															IsWritable() const noexcept { return !m_closed && !m_error; }
+
+			/**
+			 * @brief Check if the reader has reached end-of-file.
+			 * @see FIFO::EoF()
+			 */
+			constexpr bool 															EoF() const noexcept {
+				return !IsReadable() || (!IsWritable() && AvailableBytes() == 0);
+			}
+
+			/**
+			 * @brief Append bytes, all or nothing.
+			 * @param data Bytes to append.
+			 * @return Nothing on success; @ref BufferOverflow when @p data does not fit in
+			 *         FreeBytes() (nothing is written) or the buffer is not writable.
+			 */
+			constexpr Expected<void, BufferOverflow> 								Write(std::span<const std::byte> data) {
+				if (!IsWritable())
+					return StormByte::Unexpected(BufferOverflow("StaticFIFO is not writable"));
+				if (data.size() > FreeBytes())
+					return StormByte::Unexpected(BufferOverflow("Insufficient space in StaticFIFO"));
+				Append(data.begin(), data.size());
+				return {};
+			}
+
+			/**
+			 * @brief Append the bytes of a string, all or nothing.
+			 * @see Write(std::span<const std::byte>)
+			 */
+			constexpr Expected<void, BufferOverflow> 								Write(std::string_view data) {
+				if (!IsWritable())
+					return StormByte::Unexpected(BufferOverflow("StaticFIFO is not writable"));
+				if (data.size() > FreeBytes())
+					return StormByte::Unexpected(BufferOverflow("Insufficient space in StaticFIFO"));
+				Append(data.begin(), data.size());
+				return {};
+			}
+
+			/**
+			 * @brief Non-destructive read into @p out.
+			 * @param out Destination; up to out.size() bytes are copied from the read position.
+			 * @return Bytes copied, or InsufficientData as FIFO::Read() would report it
+			 *         for a count of out.size().
+			 * @see FIFO::Read()
+			 */
+			constexpr Expected<std::size_t, InsufficientData> 						Read(std::span<std::byte> out) {
+				std::size_t size = 0;
+				// An empty span asks for nothing, unlike a count of 0
+				if (const char* error = out.empty() ? Check(0, 0, size) : Check(out.size(), AvailableBytes(), size))
+					return StormByte::Unexpected(InsufficientData(error));
+				CopyOut(m_position_offset, size, out.begin());
+				m_position_offset += size;
+				return size;
+			}
+
+			/**
+			 * @brief Non-destructive read of @p count bytes; 0 reads everything available.
+			 * @see FIFO::Read()
+			 */
+			constexpr ExpectedData<InsufficientData> 								Read(std::size_t count = 0) {
+				std::size_t size = 0;
+				if (const char* error = Check(count, AvailableBytes(), size))
+					return StormByte::Unexpected(InsufficientData(error));
+				std::vector<std::byte> result(size);
+				CopyOut(m_position_offset, size, result.begin());
+				m_position_offset += size;
+				return result;
+			}
+
+			/**
+			 * @brief Destructive read into @p out from the head of the buffer.
+			 * @param out Destination; up to out.size() bytes are moved out.
+			 * @return Bytes extracted, or InsufficientData as FIFO::Extract() would report it
+			 *         for a count of out.size().
+			 * @see FIFO::Extract()
+			 */
+			constexpr Expected<std::size_t, InsufficientData> 						Extract(std::span<std::byte> out) {
+				std::size_t size = 0;
+				// An empty span asks for nothing, unlike a count of 0
+				if (const char* error = out.empty() ? Check(0, 0, size) : Check(out.size(), m_size, size))
+					return StormByte::Unexpected(InsufficientData(error));
+				CopyOut(0, size, out.begin());
+				Remove(size);
+				return size;
+			}
+
+			/**
+			 * @brief Destructive read of @p count bytes; 0 extracts everything.
+			 * @see FIFO::Extract()
+			 */
+			constexpr ExpectedData<InsufficientData> 								Extract(std::size_t count = 0) {
+				std::size_t size = 0;
+				if (const char* error = Check(count, m_size, size))
+					return StormByte::Unexpected(InsufficientData(error));
+				std::vector<std::byte> result(size);
+				CopyOut(0, size, result.begin());
+				Remove(size);
+				return result;
+			}
+
+			/**
+			 * @brief Move the read position, clamped to [0, Size()].
+			 * @see FIFO::Seek()
+			 */
+			constexpr void 															Seek(const std::ptrdiff_t& offset, const Position& mode) noexcept {
+				const std::ptrdiff_t target = mode == Position::Absolute ? offset : static_cast<std::ptrdiff_t>(m_position_offset) + offset;
+				m_position_offset = target < 0 ? 0 : std::min(static_cast<std::size_t>(target), m_size);
+			}
+
+		private:
+			static constexpr bool PowerOfTwo = (N & (N - 1)) == 0;			///< Whether Wrap() can mask
+
+			std::array<std::byte, N> m_data;								///< Inline ring storage
+			std::size_t m_head = 0;											///< Index of the first stored byte
+			std::size_t m_size = 0;											///< Number of stored bytes
+			std::size_t m_position_offset = 0;								///< Read position relative to the head
+			bool m_closed = false;											///< Closed for writes
+			bool m_error = false;											///< Error state
+
+			/**
+			 * @brief Map a position in [0, 2N) to a storage index.
+			 */
+			static constexpr std::size_t 											Wrap(std::size_t index) noexcept {
+				if constexpr (PowerOfTwo) return index & (N - 1);
+				else return index >= N ? index - N : index;
+			}
+
+			/**
+			 * @brief Apply the FIFO error rules to a request of @p count bytes with @p available stored.
+			 * @param size Set to the bytes to transfer (0 count means all of @p available).
+			 * @return Error message, or nullptr when the request can be served.
+			 */
+			constexpr const char* 													Check(std::size_t count, std::size_t available, std::size_t& size) const noexcept {
+				if (!IsReadable()) return "StaticFIFO is not readable";
+				if (count > 0 && available == 0) return "Insufficient data to read";
+				if (m_closed && count > available) return "Insufficient data in closed StaticFIFO";
+				size = count == 0 ? available : std::min(count, available);
+				return nullptr;
+			}
+
+			/**
+			 * @brief Copy @p size bytes or chars starting at @p first to the tail.
+			 */
+			template<class Iterator>
+			constexpr void 															Append(Iterator first, std::size_t size) noexcept {
+				const std::size_t tail = Wrap(m_head + m_size);
+				const std::size_t run = std::min(size, N - tail);
+				std::transform(first, first + run, m_data.begin() + tail, [](auto c) { return static_cast<std::byte>(c); });
+				std::transform(first + run, first + size, m_data.begin(), [](auto c) { return static_cast<std::byte>(c); });
+				m_size += size;
+			}
+
+			/**
+			 * @brief Copy @p size stored bytes starting @p offset bytes after the head to @p out.
+			 */
+			template<class Iterator>
+			constexpr void 															CopyOut(std::size_t offset, std::size_t size, Iterator out) const noexcept {
+				const std::size_t start = Wrap(m_head + offset);
+				const std::size_t run = std::min(size, N - start);
+				out = std::copy_n(m_data.begin() + start, run, out);
+				std::copy_n(m_data.begin(), size - run, out);
+			}
+
+			/**
+			 * @brief Drop @p size bytes from the head.
+			 */
+			constexpr void 															Drop(std::size_t size) noexcept {
+				m_size -= size;
+				m_head = m_size == 0 ? 0 : Wrap(m_head + size);
+			}
+
+			/**
+			 * @brief Drop @p size extracted bytes and move the read position back accordingly.
+			 */
+			constexpr void 															Remove(std::size_t size) noexcept {
+				Drop(size);
+				m_position_offset = m_position_offset > size ? m_position_offset - size : 0;
+			}
+	};
+}
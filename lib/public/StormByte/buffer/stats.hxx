@@ -0,0 +1,84 @@
+#pragma once
+
+#include <StormByte/buffer/config.h>
+#include <StormByte/buffer/visibility.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @struct Statistics
+	 * @brief Snapshot of the usage counters of a single buffer.
+	 *
+	 * @details Counters are only maintained when the library is built with
+	 *          @c ENABLE_STATS (which defines @c STORMBYTE_BUFFER_STATS). Otherwise
+	 *          every field stays zero and @ref Enabled is false.
+	 * @see FIFO::Stats()
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC Statistics {
+		#ifdef STORMBYTE_BUFFER_STATS
+		static constexpr bool Enabled = true;		///< Whether counters are compiled in
+		#else
+		static constexpr bool Enabled = false;		///< Whether counters are compiled in
+		#endif
+
+		std::size_t bytes_written	= 0;			///< Bytes appended by Write()
+		std::size_t bytes_read		= 0;			///< Bytes returned by non-destructive Read()
+		std::size_t bytes_extracted	= 0;			///< Bytes removed by Extract()
+		std::size_t peak_size		= 0;			///< Largest Size() observed after a write
+		std::size_t writes			= 0;			///< Number of successful non-empty writes
+		std::size_t waits			= 0;			///< Times a reader had to block (SharedFIFO)
+		std::size_t notifies		= 0;			///< Condition variable notifications sent (SharedFIFO)
+		std::chrono::nanoseconds wait_time { 0 };	///< Total time readers spent blocked (SharedFIFO)
+	};
+
+	/**
+	 * @class StatisticsCounters
+	 * @brief Internal per buffer counters backing @ref Statistics.
+	 *
+	 * @details When statistics are disabled this is an empty class whose members
+	 *          are empty inline functions, so buffers store it with
+	 *          @c [[no_unique_address]] and every call compiles away. Not thread-safe:
+	 *          thread-safe buffers update it while holding their own lock.
+	 */
+	class StatisticsCounters {
+		public:
+			#ifdef STORMBYTE_BUFFER_STATS
+			inline void OnWrite(std::size_t bytes, std::size_t size) noexcept {
+				m_stats.bytes_written += bytes;
+				m_stats.writes++;
+				m_stats.peak_size = std::max(m_stats.peak_size, size);
+			}
+			inline void OnRead(std::size_t bytes) noexcept		{ m_stats.bytes_read += bytes; }
+			inline void OnExtract(std::size_t bytes) noexcept	{ m_stats.bytes_extracted += bytes; }
+			inline void OnWait(std::chrono::nanoseconds time) noexcept {
+				m_stats.waits++;
+				m_stats.wait_time += time;
+			}
+			inline void OnNotify() noexcept						{ m_stats.notifies++; }
+			inline Statistics Snapshot() const noexcept			{ return m_stats; }
+			inline void Reset() noexcept						{ m_stats = {}; }
+
+		private:
+			Statistics m_stats;
+			#else
+			inline void OnWrite(std::size_t, std::size_t) noexcept {}
+			inline void OnRead(std::size_t) noexcept {}
+			inline void OnExtract(std::size_t) noexcept {}
+			inline void OnWait(std::chrono::nanoseconds) noexcept {}
+			inline void OnNotify() noexcept {}
+			inline Statistics Snapshot() const noexcept			{ return {}; }
+			inline void Reset() noexcept {}
+			#endif
+	};
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <StormByte/buffer/visibility.h>
+
+#include <cstdint>
+
+/**
+ * @namespace Buffer
+ * @brief Namespace for buffer-related components in the StormByte library.
+ *
+ * The Buffer namespace provides classes and utilities for byte buffers,
+ * including FIFO buffers, thread-safe shared buffers, producer-consumer
+ * interfaces, and multi-stage processing pipelines.
+ */
+namespace StormByte::Buffer {
+	/**
+	 * @enum HugePages
+	 * @brief Whether ring storage is backed by huge pages.
+	 */
+	enum class HugePages: std::uint8_t {
+		None,			///< Regular pages
+		Transparent,	///< Transparent huge pages, requested with @c madvise(MADV_HUGEPAGE)
+		Explicit		///< Pages from the hugetlbfs pool; transparent huge pages when the pool is empty
+	};
+
+	/**
+	 * @struct StorageOptions
+	 * @brief How a FIFO backs its ring storage.
+	 *
+	 * @details By default the ring is allocated from the FIFO memory resource and a region
+	 *          that crosses the end of the storage comes back as two spans. Setting
+	 *          @ref mirrored, @ref huge_pages, @ref lock or @ref numa_node maps the storage
+	 *          directly from the OS instead, bypassing the memory resource, with a capacity
+	 *          rounded up to whole pages. Options the platform cannot honour are dropped by
+	 *          FIFO::SetStorage(), so FIFO::Storage() reports what is in effect.
+	 *
+	 *          For latency critical buffers, combine @ref prefault (or @ref lock) with
+	 *          FIFO::Reserve(): the steady state then never takes a page fault.
+	 * @see FIFO::SetStorage(), Pipeline::SetStorage(), Pipeline::SetStageNode()
+	 */
+	struct STORMBYTE_BUFFER_PUBLIC StorageOptions {
+		#if defined(__linux__)
+		static constexpr bool MappingSupported = true;		///< Whether mapped storage options can be honoured
+		#else
+		static constexpr bool MappingSupported = false;		///< Whether mapped storage options can be honoured
+		#endif
+		static constexpr int AnyNode = -1;					///< @ref numa_node value leaving placement to the OS
+		static constexpr int LocalNode = -2;				///< @ref numa_node value placing pages on the node that first touches them
+
+		/**
+		 * @brief Map the ring twice, back to back, in virtual memory (Linux).
+		 * @details The storage is a @c memfd_create file mapped at two adjacent addresses,
+		 *          so the byte after the last one is the first one again. Every stored
+		 *          region is then a single contiguous span: FIFO::Peek() never copies and
+		 *          writes never split.
+		 */
+		bool mirrored = false;
+
+		/**
+		 * @brief Back the storage with huge pages (Linux).
+		 * @details Fewer TLB misses and page faults for large rings. With
+		 *          HugePages::Explicit capacity is a multiple of the huge page size.
+		 */
+		HugePages huge_pages = HugePages::None;
+
+		/**
+		 * @brief @c mlock the storage so it is resident and never paged out (Linux).
+		 * @details Best effort: storage that exceeds @c RLIMIT_MEMLOCK is left unlocked.
+		 */
+		bool lock = false;
+
+		/**
+		 * @brief Fault every page in as soon as storage is allocated or reserved.
+		 * @details Also applies to storage from the memory resource. Idle page trimming
+		 *          (RetentionPolicy::trim_threshold) is disabled while this or @ref lock is set.
+		 */
+		bool prefault = false;
+
+		/**
+		 * @brief NUMA node the storage is allocated on (Linux).
+		 * @details A node number makes the storage prefer that node's memory. @ref LocalNode
+		 *          places each page on the node of the thread that first writes it, which for
+		 *          a FIFO is its producer, whatever the process wide memory policy; combined
+		 *          with @ref prefault that is the thread calling FIFO::Reserve() instead.
+		 *          A node that does not exist or has no memory is dropped back to @ref AnyNode.
+		 */
+		int numa_node = AnyNode;
+
+		bool operator==(const StorageOptions&) const noexcept = default;
+	};
+}
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <StormByte/buffer/exception.hxx>
+#include <StormByte/buffer/small_bytes.hxx>
 #include <StormByte/expected.hxx>
 #include <StormByte/logger.hxx>
 
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 /**
@@ -37,6 +39,30 @@ namespace StormByte::Buffer {
 	template<class Exception>
 	using ExpectedData = Expected<std::vector<std::byte>, Exception>;
 
+	/**
+	 * @brief Type alias for Expected containing byte data allocated from a memory resource.
+	 * @tparam Exception The exception type to use for error cases.
+	 *
+	 * @details Returned by the Read()/Extract() overloads taking a
+	 *          @c std::pmr::memory_resource, so results can live in an arena or pool.
+	 *
+	 * @see ExpectedData
+	 */
+	template<class Exception>
+	using ExpectedPmrData = Expected<std::pmr::vector<std::byte>, Exception>;
+
+	/**
+	 * @brief Type alias for Expected containing byte data with inline capacity.
+	 * @tparam Exception The exception type to use for error cases.
+	 *
+	 * @details Returned by ExtractSmall(): messages up to SmallBytes::InlineCapacity
+	 *          bytes come back without a heap allocation.
+	 *
+	 * @see ExpectedData, SmallBytes
+	 */
+	template<class Exception>
+	using ExpectedSmallData = Expected<SmallBytes, Exception>;
+
 	/**
 	 * @brief Type alias for pipeline transformation functions.
 	 * 
@@ -0,0 +1,95 @@
+#include "alloc_counter.hxx"
+
+#include <StormByte/platform.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<std::size_t> g_allocations { 0 };
+	std::atomic<std::size_t> g_deallocations { 0 };
+	std::atomic<std::size_t> g_bytes { 0 };
+
+	void* Allocate(std::size_t size) noexcept {
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+		g_bytes.fetch_add(size, std::memory_order_relaxed);
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	void* AllocateAligned(std::size_t size, std::align_val_t align) noexcept {
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+		g_bytes.fetch_add(size, std::memory_order_relaxed);
+		const std::size_t alignment = static_cast<std::size_t>(align);
+		#ifdef WINDOWS
+		return _aligned_malloc(size == 0 ? 1 : size, alignment);
+		#else
+		// aligned_alloc requires the size to be a multiple of the alignment
+		const std::size_t rounded = ((size == 0 ? 1 : size) + alignment - 1) / alignment * alignment;
+		return std::aligned_alloc(alignment, rounded);
+		#endif
+	}
+
+	void Deallocate(void* ptr) noexcept {
+		if (!ptr) return;
+		g_deallocations.fetch_add(1, std::memory_order_relaxed);
+		std::free(ptr);
+	}
+
+	void DeallocateAligned(void* ptr) noexcept {
+		if (!ptr) return;
+		g_deallocations.fetch_add(1, std::memory_order_relaxed);
+		#ifdef WINDOWS
+		_aligned_free(ptr);
+		#else
+		std::free(ptr);
+		#endif
+	}
+}
+
+StormByte::Buffer::Test::AllocationStats StormByte::Buffer::Test::Allocations() noexcept {
+	return {
+		g_allocations.load(std::memory_order_relaxed),
+		g_deallocations.load(std::memory_order_relaxed),
+		g_bytes.load(std::memory_order_relaxed)
+	};
+}
+
+void* operator new(std::size_t size) {
+	if (void* ptr = Allocate(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	if (void* ptr = Allocate(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+	if (void* ptr = AllocateAligned(size, align)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+	if (void* ptr = AllocateAligned(size, align)) return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { DeallocateAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { DeallocateAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { DeallocateAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { DeallocateAligned(ptr); }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @namespace Test
+ * @brief Support code shared by the StormByte Buffer tests and benchmarks.
+ */
+namespace StormByte::Buffer::Test {
+	/**
+	 * @struct AllocationStats
+	 * @brief Snapshot of the global allocation counters.
+	 */
+	struct AllocationStats {
+		std::size_t allocations		= 0;	///< Number of calls to any global operator new
+		std::size_t deallocations	= 0;	///< Number of calls to any global operator delete (non null)
+		std::size_t bytes			= 0;	///< Total bytes requested through global operator new
+	};
+
+	/**
+	 * @brief Get the current values of the global allocation counters.
+	 * @return Counters accumulated since program start.
+	 * @details Counters are maintained by the replacement global @c operator new / @c operator delete
+	 *          defined in alloc_counter.cxx, which must be linked into the executable. Allocations
+	 *          done from the library are only observed when the platform resolves global operator new
+	 *          to the executable's definition (ELF shared objects do, Windows DLLs do not).
+	 */
+	AllocationStats Allocations() noexcept;
+
+	/**
+	 * @brief Difference between two snapshots.
+	 */
+	inline AllocationStats operator-(const AllocationStats& lhs, const AllocationStats& rhs) noexcept {
+		return { lhs.allocations - rhs.allocations, lhs.deallocations - rhs.deallocations, lhs.bytes - rhs.bytes };
+	}
+
+	/**
+	 * @class AllocationScope
+	 * @brief Counts the global allocations performed since its construction.
+	 *
+	 * @details Counters are process wide, so allocations from every thread (for example
+	 *          pipeline stage threads) are included while the scope is alive.
+	 * @code
+	 * AllocationScope scope;
+	 * fifo.Seek(0, Position::Absolute);
+	 * ASSERT_EQUAL("seek does not allocate", scope.Count(), 0);
+	 * @endcode
+	 */
+	class AllocationScope {
+		public:
+			AllocationScope() noexcept: m_start(Allocations()) {}
+
+			/** @brief Counters accumulated since construction (or the last Reset()). */
+			AllocationStats Delta() const noexcept { return Allocations() - m_start; }
+
+			/** @brief Number of allocations since construction (or the last Reset()). */
+			std::size_t Count() const noexcept { return Delta().allocations; }
+
+			/** @brief Allocations not yet matched by a deallocation. */
+			std::ptrdiff_t Outstanding() const noexcept {
+				const AllocationStats delta = Delta();
+				return static_cast<std::ptrdiff_t>(delta.allocations) - static_cast<std::ptrdiff_t>(delta.deallocations);
+			}
+
+			/** @brief Restart counting from now. */
+			void Reset() noexcept { m_start = Allocations(); }
+
+		private:
+			AllocationStats m_start;
+	};
+}
@@ -0,0 +1,291 @@
+/**
+ * @file allocation_test.cxx
+ * @brief Allocation guardrails for buffer hot paths
+ *
+ * Uses the replacement global operator new/delete from alloc_counter.cxx to
+ * count heap allocations inside a scope and assert that hot paths do not
+ * allocate (or stay within a known bound) so allocation regressions are caught.
+ */
+
+#include <StormByte/buffer/fifo.hxx>
+#include <StormByte/buffer/pipeline.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+#include <StormByte/test_handlers.h>
+
+#include "alloc_counter.hxx"
+
+#include <array>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using StormByte::Buffer::Consumer;
+using StormByte::Buffer::ExecutionMode;
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::Pipeline;
+using StormByte::Buffer::Position;
+using StormByte::Buffer::Producer;
+using StormByte::Buffer::SharedFIFO;
+using StormByte::Buffer::Test::AllocationScope;
+
+int test_allocation_scope_counts() {
+    AllocationScope scope;
+    {
+        auto value = std::make_unique<int>(42);
+        ASSERT_EQUAL("one allocation counted", scope.Count(), static_cast<std::size_t>(1));
+        ASSERT_EQUAL("one allocation outstanding", scope.Outstanding(), static_cast<std::ptrdiff_t>(1));
+    }
+    ASSERT_EQUAL("released after scope", scope.Outstanding(), static_cast<std::ptrdiff_t>(0));
+    scope.Reset();
+    ASSERT_EQUAL("reset clears count", scope.Count(), static_cast<std::size_t>(0));
+    RETURN_TEST("test_allocation_scope_counts", 0);
+}
+
+int test_fifo_write_string_no_temporary() {
+    FIFO fifo;
+    const std::string message(15, 'm');
+    for (int i = 0; i < 8; ++i) fifo.Write(message); // warm up: storage block and chunk trace metadata
+    fifo.Clear();
+
+    AllocationScope scope;
+    for (int i = 0; i < 8; ++i) fifo.Write(message);
+    // No per-write temporary: 120 bytes may cross at most one storage block boundary
+    ASSERT_TRUE("string writes do not allocate temporaries", scope.Count() <= 1);
+    ASSERT_EQUAL("data written", fifo.Size(), static_cast<std::size_t>(8 * 15));
+    RETURN_TEST("test_fifo_write_string_no_temporary", 0);
+}
+
+int test_shared_fifo_write_string_no_temporary() {
+    SharedFIFO fifo;
+    const std::string message(15, 's');
+    for (int i = 0; i < 8; ++i) fifo.Write(message);
+    fifo.Clear();
+
+    AllocationScope scope;
+    for (int i = 0; i < 8; ++i) fifo.Write(message);
+    // No per-write temporary: 120 bytes may cross at most one storage block boundary
+    ASSERT_TRUE("string writes do not allocate temporaries", scope.Count() <= 1);
+    ASSERT_EQUAL("data written", fifo.Size(), static_cast<std::size_t>(8 * 15));
+    RETURN_TEST("test_shared_fifo_write_string_no_temporary", 0);
+}
+
+int test_fifo_queries_and_seek_no_allocation() {
+    FIFO fifo;
+    fifo.Write(std::string(100, 'q'));
+
+    AllocationScope scope;
+    fifo.Seek(10, Position::Absolute);
+    fifo.Seek(5, Position::Relative);
+    fifo.Seek(-3, Position::Relative);
+    std::size_t total = fifo.Size() + fifo.AvailableBytes();
+    bool flags = fifo.Empty() || fifo.EoF() || !fifo.IsReadable();
+    fifo.Clean();
+    ASSERT_EQUAL("queries, seek and clean do not allocate", scope.Count(), static_cast<std::size_t>(0));
+    ASSERT_EQUAL("clean removed read bytes", fifo.Size(), static_cast<std::size_t>(88));
+    ASSERT_FALSE("flags", flags);
+    ASSERT_EQUAL("sizes", total, static_cast<std::size_t>(188));
+    RETURN_TEST("test_fifo_queries_and_seek_no_allocation", 0);
+}
+
+int test_fifo_steady_state_write_extract_bounded() {
+    constexpr std::size_t cycles = 1000;
+    constexpr std::size_t chunk = 64;
+    FIFO fifo;
+    const std::vector<std::byte> payload(chunk, std::byte { 0x42 });
+    fifo.Write(payload);
+    (void)fifo.Extract(chunk);
+
+    AllocationScope scope;
+    for (std::size_t i = 0; i < cycles; ++i) {
+        fifo.Write(payload);
+        auto out = fifo.Extract(chunk);
+        if (!out || out->size() != chunk) {
+            RETURN_TEST("test_fifo_steady_state_write_extract_bounded extract", 1);
+        }
+    }
+    // Extract(count) returns a new vector by contract: one per call, the retained
+    // ring storage is reused. The zero allocation path is checked below
+    ASSERT_EQUAL("steady state allocations bounded", scope.Count(), cycles);
+    RETURN_TEST("test_fifo_steady_state_write_extract_bounded", 0);
+}
+
+int test_fifo_steady_state_zero_copy_no_allocation() {
+    constexpr std::size_t cycles = 1000;
+    constexpr std::size_t chunk = 64;
+    FIFO fifo;
+    const std::vector<std::byte> payload(chunk, std::byte { 0x42 });
+    // Result vectors come from a stack arena that is released every cycle
+    std::array<std::byte, 4096> storage;
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+    fifo.Write(payload);
+    (void)fifo.Extract(chunk, &arena);
+    arena.release();
+
+    AllocationScope scope;
+    for (std::size_t i = 0; i < cycles; ++i) {
+        fifo.Write(payload);
+        if (fifo.Peek(chunk).size() != chunk) {
+            RETURN_TEST("test_fifo_steady_state_zero_copy_no_allocation peek", 1);
+        }
+        fifo.Seek(chunk, Position::Relative);
+        fifo.Clean();
+        fifo.Write(payload);
+        auto out = fifo.Extract(chunk, &arena);
+        if (!out || out->size() != chunk) {
+            RETURN_TEST("test_fifo_steady_state_zero_copy_no_allocation extract", 1);
+        }
+        arena.release();
+    }
+    ASSERT_EQUAL("steady state write/extract does not allocate", scope.Count(), static_cast<std::size_t>(0));
+    RETURN_TEST("test_fifo_steady_state_zero_copy_no_allocation", 0);
+}
+
+int test_fifo_small_messages_no_allocation() {
+    const std::string message(48, 'c');
+    // Chunk tracing keeps a per thread context on the heap; size it first
+    {
+        FIFO warm_up;
+        warm_up.Write(message);
+        (void)warm_up.ExtractSmall(0);
+    }
+
+    AllocationScope scope;
+    for (int i = 0; i < 16; ++i) {
+        FIFO fifo;
+        fifo.Write(message);
+        auto data = fifo.ExtractSmall(message.size());
+        if (!data || data->size() != message.size()) {
+            RETURN_TEST("test_fifo_small_messages_no_allocation extract", 1);
+        }
+    }
+    // Chunk tracing (when enabled) gives every new buffer its own trace queue
+    const std::size_t expected = StormByte::Buffer::ChunkTrace::Enabled ? 16 : 0;
+    ASSERT_EQUAL("small messages stay inline", scope.Count(), expected);
+    RETURN_TEST("test_fifo_small_messages_no_allocation", 0);
+}
+
+int test_pipeline_repeated_process_no_growth() {
+    Pipeline pipeline;
+    for (int i = 0; i < 2; ++i) {
+        pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+            while (true) {
+                auto data = in.Extract(16);
+                if (!data || data->empty()) {
+                    if (!data || in.EoF()) break;
+                    continue;
+                }
+                out.Write(*data);
+            }
+            out.Close();
+        });
+    }
+    const std::string payload(64, 'p');
+
+    auto run = [&]() -> std::size_t {
+        Producer input;
+        input.Write(payload);
+        input.Close();
+        Consumer output = pipeline.Process(input.Consumer(), ExecutionMode::Sync, nullptr);
+        auto data = output.Extract(0);
+        return data ? data->size() : 0;
+    };
+
+    // First run sizes internal containers
+    ASSERT_EQUAL("first run output", run(), payload.size());
+    AllocationScope scope;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQUAL("repeated run output", run(), payload.size());
+    }
+    // Every run releases what the previous run held, so nothing accumulates
+    ASSERT_EQUAL("repeated Process does not accumulate allocations", scope.Outstanding(), static_cast<std::ptrdiff_t>(0));
+    RETURN_TEST("test_pipeline_repeated_process_no_growth", 0);
+}
+
+int test_memory_resource_bypasses_global_heap() {
+    // Every allocation must come from the arena: the null upstream throws otherwise
+    std::array<std::byte, 256 * 1024> storage;
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+    const std::string message(100, 'r');
+
+    // The buffer object itself lives in the arena, but std::condition_variable_any
+    // may allocate internal state from the global heap, so construct it first
+    Producer producer(&arena);
+    Consumer consumer = producer.Consumer();
+    // Chunk tracing (when enabled) keeps a per thread context on the heap; size it first
+    FIFO warm_up;
+    for (int i = 0; i < 16; ++i) warm_up.Write(message);
+    (void)warm_up.Extract(0);
+
+    AllocationScope scope;
+    {
+        for (int i = 0; i < 64; ++i) producer.Write(message);
+        auto data = consumer.Extract(1000, &arena);
+        ASSERT_TRUE("extract from arena", data.has_value() && data->size() == 1000);
+        FIFO fifo(&arena);
+        fifo.Write(std::span<const std::byte>(*data));
+        auto all = fifo.Extract(0, &arena);
+        ASSERT_TRUE("fifo extract from arena", all.has_value() && all->size() == 1000);
+    }
+    ASSERT_EQUAL("no global heap allocations", scope.Count(), static_cast<std::size_t>(0));
+    RETURN_TEST("test_memory_resource_bypasses_global_heap", 0);
+}
+
+int test_pipeline_arena_reduces_heap_traffic() {
+    auto make_pipeline = [](std::size_t arena_size) {
+        Pipeline pipeline;
+        pipeline.SetArenaSize(arena_size);
+        for (int i = 0; i < 3; ++i) {
+            pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+                while (!in.EoF()) {
+                    auto data = in.Extract(0, in.MemoryResource());
+                    if (data && !data->empty()) out.Write(std::span<const std::byte>(*data));
+                }
+                out.Close();
+            });
+        }
+        return pipeline;
+    };
+    const std::string payload(4096, 'a');
+    auto heap_allocations = [&](Pipeline& pipeline) {
+        auto run = [&]() {
+            Producer input;
+            input.Write(payload);
+            input.Close();
+            (void)pipeline.Process(input.Consumer(), ExecutionMode::Sync, nullptr).Extract(0);
+        };
+        run(); // sizes internal containers
+        AllocationScope scope;
+        for (int i = 0; i < 4; ++i) run();
+        return scope.Count();
+    };
+
+    Pipeline heap = make_pipeline(0);
+    Pipeline arena = make_pipeline(64 * 1024);
+    const std::size_t without = heap_allocations(heap);
+    const std::size_t with = heap_allocations(arena);
+    ASSERT_TRUE("arena removes intermediate heap allocations", with < without);
+    RETURN_TEST("test_pipeline_arena_reduces_heap_traffic", 0);
+}
+
+int main() {
+    int result = 0;
+    result += test_allocation_scope_counts();
+    result += test_fifo_write_string_no_temporary();
+    result += test_shared_fifo_write_string_no_temporary();
+    result += test_fifo_queries_and_seek_no_allocation();
+    result += test_fifo_steady_state_write_extract_bounded();
+    result += test_fifo_steady_state_zero_copy_no_allocation();
+    result += test_fifo_small_messages_no_allocation();
+    result += test_pipeline_repeated_process_no_growth();
+    result += test_memory_resource_bypasses_global_heap();
+    result += test_pipeline_arena_reduces_heap_traffic();
+
+    if (result == 0) {
+        std::cout << "Allocation tests passed!" << std::endl;
+    } else {
+        std::cout << result << " Allocation tests failed." << std::endl;
+    }
+    return result;
+}
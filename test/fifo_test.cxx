@@ -2,13 +2,26 @@
 #include <StormByte/string.hxx>
 #include <StormByte/test_handlers.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory_resource>
+#include <span>
 #include <vector>
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #include <string>
 #include <random>
 
 using StormByte::Buffer::FIFO;
+using StormByte::Buffer::HugePages;
 using StormByte::Buffer::Position;
+using StormByte::Buffer::RetentionPolicy;
+using StormByte::Buffer::StorageOptions;
 
 int test_fifo_write_read_vector() {
     FIFO fifo;
@@ -634,6 +647,498 @@ int test_fifo_extract_after_error() {
 	RETURN_TEST("test_fifo_extract_after_error", 0);
 }
 
+int test_fifo_stats() {
+    FIFO fifo;
+    fifo.Write(std::string("ABCDEFGH"));
+    fifo.Write(std::string("IJ"));
+    (void)fifo.Read(3);
+    (void)fifo.Extract(5);
+    fifo.Write(std::string("K"));
+    const auto stats = fifo.Stats();
+    if constexpr (StormByte::Buffer::Statistics::Enabled) {
+        ASSERT_EQUAL("stats bytes written", stats.bytes_written, static_cast<std::size_t>(11));
+        ASSERT_EQUAL("stats writes", stats.writes, static_cast<std::size_t>(3));
+        ASSERT_EQUAL("stats bytes read", stats.bytes_read, static_cast<std::size_t>(3));
+        ASSERT_EQUAL("stats bytes extracted", stats.bytes_extracted, static_cast<std::size_t>(5));
+        ASSERT_EQUAL("stats peak size", stats.peak_size, static_cast<std::size_t>(10));
+    } else {
+        ASSERT_EQUAL("stats disabled bytes written", stats.bytes_written, static_cast<std::size_t>(0));
+        ASSERT_EQUAL("stats disabled writes", stats.writes, static_cast<std::size_t>(0));
+    }
+    RETURN_TEST("test_fifo_stats", 0);
+}
+
+int test_fifo_chunk_trace_propagation() {
+    using StormByte::Buffer::ChunkTrace;
+    using StormByte::Buffer::ChunkTracing;
+    ChunkTracing::Clear();
+    FIFO first, second, unrelated;
+    first.Write(std::string("AAAA"));
+    first.Write(std::string("BBBB"));
+    first.Write(std::string("CCCC"));
+    (void)first.Extract(4);
+    const auto single = ChunkTracing::LastExtracted();
+    // Forwarding one chunk keeps its identity, and consumes the context
+    second.Write(std::string("xyz"));
+    const auto consumed = ChunkTracing::LastExtracted();
+    unrelated.Write(std::string("other"));
+    (void)second.Extract(0);
+    const auto forwarded = ChunkTracing::LastExtracted();
+    (void)unrelated.Extract(0);
+    const auto fresh = ChunkTracing::LastExtracted();
+    // Several chunks merged into one write get a new identity
+    (void)first.Extract(6);
+    const auto spanning = ChunkTracing::LastExtracted();
+    second.Write(std::string("merged"));
+    (void)second.Extract(0);
+    const auto merged = ChunkTracing::LastExtracted();
+    (void)first.Extract(0);
+    const auto rest = ChunkTracing::LastExtracted();
+    ChunkTracing::Clear();
+    if constexpr (ChunkTrace::Enabled) {
+        ASSERT_EQUAL("extract of one chunk", single.size(), static_cast<std::size_t>(1));
+        ASSERT_TRUE("write consumes the context", consumed.empty());
+        ASSERT_EQUAL("forwarded chunk count", forwarded.size(), static_cast<std::size_t>(1));
+        ASSERT_EQUAL("forwarded keeps sequence", forwarded[0].sequence, single[0].sequence);
+        ASSERT_TRUE("forwarded keeps ingest", forwarded[0].ingest == single[0].ingest);
+        ASSERT_EQUAL("unrelated chunk count", fresh.size(), static_cast<std::size_t>(1));
+        ASSERT_TRUE("unrelated buffer starts a new chunk", fresh[0].sequence > single[0].sequence);
+        ASSERT_EQUAL("extract spans two chunks", spanning.size(), static_cast<std::size_t>(2));
+        ASSERT_TRUE("chunks in write order", spanning[0].sequence < spanning[1].sequence);
+        ASSERT_EQUAL("merged chunk count", merged.size(), static_cast<std::size_t>(1));
+        ASSERT_TRUE("merged write starts a new chunk", merged[0].sequence > fresh[0].sequence);
+        ASSERT_EQUAL("rest of partial chunk", rest.size(), static_cast<std::size_t>(1));
+        ASSERT_EQUAL("rest sequence", rest[0].sequence, spanning[1].sequence);
+    } else {
+        ASSERT_TRUE("tracing disabled", single.empty() && forwarded.empty());
+    }
+    RETURN_TEST("test_fifo_chunk_trace_propagation", 0);
+}
+
+int test_fifo_memory_resource() {
+    std::pmr::unsynchronized_pool_resource pool;
+    FIFO fifo(&pool);
+    ASSERT_TRUE("storage resource", fifo.MemoryResource() == &pool);
+    const std::pmr::vector<std::byte> bytes({ std::byte { 'a' }, std::byte { 'b' }, std::byte { 'c' } }, &pool);
+    ASSERT_TRUE("span write", fifo.Write(std::span<const std::byte>(bytes)));
+    fifo.Write(std::string("def"));
+
+    std::pmr::monotonic_buffer_resource arena;
+    auto read = fifo.Read(2, &arena);
+    ASSERT_TRUE("pmr read", read.has_value());
+    ASSERT_TRUE("read result resource", read->get_allocator().resource() == &arena);
+    ASSERT_EQUAL("pmr read size", read->size(), static_cast<std::size_t>(2));
+    auto extracted = fifo.Extract(0, &arena);
+    ASSERT_TRUE("pmr extract", extracted.has_value());
+    ASSERT_TRUE("extract result resource", extracted->get_allocator().resource() == &arena);
+    ASSERT_EQUAL("pmr extract content", std::string(reinterpret_cast<const char*>(extracted->data()), extracted->size()), std::string("abcdef"));
+
+    FIFO moved(std::move(fifo));
+    ASSERT_TRUE("move keeps resource", moved.MemoryResource() == &pool);
+    FIFO copied(moved);
+    ASSERT_TRUE("copy uses default resource", copied.MemoryResource() == std::pmr::get_default_resource());
+    RETURN_TEST("test_fifo_memory_resource", 0);
+}
+
+int test_fifo_reserve_and_ring_wrap() {
+    auto text = [](std::size_t size, char first) {
+        std::string result(size, ' ');
+        for (std::size_t i = 0; i < size; ++i) result[i] = static_cast<char>(first + i % 26);
+        return result;
+    };
+    FIFO fifo;
+    ASSERT_EQUAL("inline storage", fifo.Capacity(), FIFO::InlineCapacity);
+    fifo.Reserve(128);
+    ASSERT_EQUAL("reserved capacity", fifo.Capacity(), static_cast<std::size_t>(128));
+    const std::string first = text(80, 'a');
+    const std::string second = text(80, 'A');
+    fifo.Write(first);
+    ASSERT_EQUAL("extract head", StormByte::String::FromByteVector(*fifo.Extract(48)), first.substr(0, 48));
+    // Wraps around the end of the reserved storage without growing
+    fifo.Write(second);
+    ASSERT_EQUAL("no growth on wrap", fifo.Capacity(), static_cast<std::size_t>(128));
+    fifo.Seek(20, Position::Absolute);
+    ASSERT_EQUAL("read across the wrap", StormByte::String::FromByteVector(*fifo.Read(40)), first.substr(68) + second.substr(0, 28));
+    ASSERT_EQUAL("extract across the wrap", StormByte::String::FromByteVector(*fifo.Extract(0)), first.substr(48) + second);
+    // Growing linearizes wrapped content
+    fifo.Write(first);
+    (void)fifo.Extract(60);
+    fifo.Write(second.substr(0, 60));
+    const std::string third = text(100, '0');
+    fifo.Write(third);
+    ASSERT_TRUE("grew", fifo.Capacity() >= 180);
+    ASSERT_EQUAL("content after growth", StormByte::String::FromByteVector(*fifo.Extract(0)), first.substr(60) + second.substr(0, 60) + third);
+    ASSERT_TRUE("reserve kept when drained", fifo.Capacity() >= 128);
+
+    FIFO copy(fifo);
+    ASSERT_TRUE("copy keeps reserve", copy.Capacity() >= 128);
+    fifo.ShrinkToFit();
+    ASSERT_EQUAL("shrink to fit returns to inline storage", fifo.Capacity(), FIFO::InlineCapacity);
+    RETURN_TEST("test_fifo_reserve_and_ring_wrap", 0);
+}
+
+int test_fifo_inline_storage() {
+    FIFO fifo;
+    fifo.Write(std::string("tiny message"));
+    FIFO moved(std::move(fifo));
+    ASSERT_EQUAL("inline content moved", StormByte::String::FromByteVector(*moved.Read(0)), std::string("tiny message"));
+    ASSERT_EQUAL("moved-from is empty", fifo.Size(), static_cast<std::size_t>(0));
+
+    auto small = moved.ExtractSmall(4);
+    ASSERT_TRUE("small extract", small.has_value());
+    ASSERT_TRUE("small result is inline", small->IsInline());
+    ASSERT_EQUAL("small content", std::string(reinterpret_cast<const char*>(small->data()), small->size()), std::string("tiny"));
+
+    moved.Write(std::string(100, 'x'));
+    auto large = moved.ExtractSmall(0);
+    ASSERT_EQUAL("large small extract", large->size(), static_cast<std::size_t>(108));
+    ASSERT_FALSE("large result spills to the heap", large->IsInline());
+    moved.Close();
+    ASSERT_FALSE("closed insufficient", moved.ExtractSmall(1).has_value());
+    RETURN_TEST("test_fifo_inline_storage", 0);
+}
+
+int test_fifo_retention_policy() {
+    FIFO fifo;
+    RetentionPolicy policy;
+    policy.max_spare = 1024;
+    policy.keep_spare = 256;
+    policy.trim_threshold = 4096;
+    fifo.SetRetention(policy);
+    ASSERT_EQUAL("policy stored", fifo.Retention().max_spare, static_cast<std::size_t>(1024));
+
+    // Large burst: drained storage shrinks down to keep_spare
+    fifo.Write(std::string(8192, 'x'));
+    (void)fifo.Extract(0);
+    ASSERT_EQUAL("shrunk to keep_spare", fifo.Capacity(), static_cast<std::size_t>(256));
+
+    // Oscillation within the band keeps the storage (hysteresis)
+    fifo.Write(std::string(512, 'y'));
+    const std::size_t capacity = fifo.Capacity();
+    for (int i = 0; i < 8; ++i) {
+        (void)fifo.Extract(0);
+        ASSERT_EQUAL("storage retained", fifo.Capacity(), capacity);
+        fifo.Write(std::string(512, 'y'));
+    }
+    fifo.Clear();
+    ASSERT_EQUAL("clear retains storage", fifo.Capacity(), capacity);
+
+    // Trimmed pages read back as fresh storage, the data written afterwards is intact
+    fifo.Reserve(64 * 1024);
+    fifo.Write(std::string(60 * 1024, 'z'));
+    (void)fifo.Extract(0);
+    ASSERT_EQUAL("reserve floor kept", fifo.Capacity(), static_cast<std::size_t>(64 * 1024));
+    fifo.Write(std::string("after trim"));
+    ASSERT_EQUAL("write after trim", StormByte::String::FromByteVector(*fifo.Extract(0)), std::string("after trim"));
+    RETURN_TEST("test_fifo_retention_policy", 0);
+}
+
+int test_fifo_peek_acquire() {
+    auto as_string = [](std::span<const std::byte> bytes) {
+        return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+    const std::string digits = "0123456789012345678901234567890123456789";
+    FIFO fifo;
+    fifo.Reserve(128);
+    fifo.Write(std::string(100, 'a'));
+    (void)fifo.Extract(90);
+    // 28 bytes fit before the end of the storage, 12 wrap to the front
+    fifo.Write(digits);
+    ASSERT_EQUAL("peek before the wrap", as_string(fifo.Peek(20)), std::string(10, 'a') + digits.substr(0, 10));
+    ASSERT_EQUAL("peek across the wrap", as_string(fifo.Peek()), std::string(10, 'a') + digits);
+    ASSERT_EQUAL("peek does not grow", fifo.Capacity(), static_cast<std::size_t>(128));
+    ASSERT_EQUAL("peek keeps the read position", fifo.AvailableBytes(), static_cast<std::size_t>(50));
+
+    fifo.Seek(30, Position::Relative);
+    fifo.Clean();
+    auto space = fifo.Acquire(100);
+    ASSERT_TRUE("contiguous space", space.size() >= 100);
+    std::memset(space.data(), 'z', 100);
+    ASSERT_TRUE("commit", fifo.Commit(100));
+    ASSERT_EQUAL("acquire does not grow", fifo.Capacity(), static_cast<std::size_t>(128));
+    ASSERT_EQUAL("committed content", StormByte::String::FromByteVector(*fifo.Extract(0)), digits.substr(20) + std::string(100, 'z'));
+
+    // Every way the content can wrap around a 128 byte ring
+    for (std::size_t head : { 1, 30, 64, 100, 127 }) {
+        for (std::size_t size : { 10, 60, 100, 120, 128 }) {
+            FIFO ring;
+            ring.Reserve(128);
+            ring.Write(std::string(head + 1, '-'));
+            (void)ring.Extract(head);
+            std::string expected = "-";
+            for (std::size_t i = 1; i < size; ++i) expected += static_cast<char>('a' + i % 26);
+            ring.Write(expected.substr(1));
+            ASSERT_EQUAL("wrapped peek", as_string(ring.Peek()), expected);
+            ASSERT_EQUAL("ring kept", ring.Capacity(), static_cast<std::size_t>(128));
+            ASSERT_EQUAL("content intact", StormByte::String::FromByteVector(*ring.Extract(0)), expected);
+        }
+    }
+
+    ASSERT_FALSE("commit beyond free space", fifo.Commit(1000));
+    fifo.Close();
+    ASSERT_TRUE("closed acquire", fifo.Acquire(1).empty());
+    ASSERT_FALSE("closed commit", fifo.Commit(0));
+    RETURN_TEST("test_fifo_peek_acquire", 0);
+}
+
+int test_fifo_mirrored_storage() {
+    if constexpr (!StorageOptions::MappingSupported) {
+        RETURN_TEST("test_fifo_mirrored_storage (unsupported)", 0);
+    }
+    auto as_string = [](std::span<const std::byte> bytes) {
+        return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+    FIFO fifo;
+    fifo.Write(std::string("kept across the switch"));
+    StorageOptions options;
+    options.mirrored = true;
+    fifo.SetStorage(options);
+    ASSERT_TRUE("mirrored in effect", fifo.Storage().mirrored);
+    const std::size_t capacity = fifo.Capacity();
+    ASSERT_TRUE("whole pages", capacity >= 4096 && capacity % 4096 == 0);
+    ASSERT_EQUAL("content moved", StormByte::String::FromByteVector(*fifo.Extract(0)), std::string("kept across the switch"));
+
+    // Leave one byte just before the end of the storage
+    fifo.Write(std::string(capacity - 10, 'x'));
+    (void)fifo.Extract(capacity - 11);
+    const std::string frame = "a frame crossing the end of the ring";
+    fifo.Write(frame);
+    ASSERT_EQUAL("no growth", fifo.Capacity(), capacity);
+    const auto view = fifo.Peek();
+    ASSERT_EQUAL("one contiguous span", as_string(view), "x" + frame);
+    const auto space = fifo.Acquire(16);
+    ASSERT_TRUE("writable span", space.size() >= 16);
+    std::memcpy(space.data(), "0123456789abcdef", 16);
+    ASSERT_TRUE("commit", fifo.Commit(16));
+    ASSERT_EQUAL("peek is unchanged storage", fifo.Peek().data(), view.data());
+
+    FIFO copy(fifo);
+    ASSERT_TRUE("copy keeps the storage options", copy.Storage().mirrored);
+    FIFO moved(std::move(copy));
+    ASSERT_TRUE("move keeps the storage options", moved.Storage().mirrored);
+    ASSERT_EQUAL("moved content", StormByte::String::FromByteVector(*moved.Extract(0)), "x" + frame + "0123456789abcdef");
+
+    options.mirrored = false;
+    fifo.SetStorage(options);
+    ASSERT_FALSE("back to default storage", fifo.Storage().mirrored);
+    ASSERT_EQUAL("content", StormByte::String::FromByteVector(*fifo.Extract(0)), "x" + frame + "0123456789abcdef");
+    RETURN_TEST("test_fifo_mirrored_storage", 0);
+}
+
+int test_fifo_storage_options() {
+    if constexpr (!StorageOptions::MappingSupported) {
+        RETURN_TEST("test_fifo_storage_options (unsupported)", 0);
+    }
+    const std::string message = "locked, prefaulted and on huge pages";
+    for (bool mirrored : { false, true }) {
+        for (HugePages huge_pages : { HugePages::None, HugePages::Transparent, HugePages::Explicit }) {
+            FIFO fifo;
+            fifo.Write(message);
+            StorageOptions options;
+            options.mirrored = mirrored;
+            options.huge_pages = huge_pages;
+            options.lock = true;
+            options.prefault = true;
+            fifo.SetStorage(options);
+            ASSERT_TRUE("options in effect", fifo.Storage() == options);
+            fifo.Reserve(1024 * 1024);
+            ASSERT_TRUE("reserved", fifo.Capacity() >= 1024 * 1024);
+            if (huge_pages == HugePages::Explicit) {
+                // Rounded to the huge page size even when the pool is empty
+                ASSERT_TRUE("huge page multiple", fifo.Capacity() % (2 * 1024 * 1024) == 0);
+            }
+            for (int i = 0; i < 64; ++i) fifo.Write(std::string(16 * 1024, 'x'));
+            ASSERT_EQUAL("content kept", StormByte::String::FromByteVector(*fifo.Extract(message.size())), message);
+            ASSERT_EQUAL("content size", fifo.Size(), static_cast<std::size_t>(64 * 16 * 1024));
+        }
+    }
+    RETURN_TEST("test_fifo_storage_options", 0);
+}
+
+int test_fifo_prefault_no_page_faults() {
+#if defined(__linux__)
+    constexpr std::size_t capacity = 4 * 1024 * 1024;
+    auto minor_faults = [] {
+        rusage usage {};
+        ::getrusage(RUSAGE_THREAD, &usage);
+        return usage.ru_minflt;
+    };
+    const std::vector<std::byte> chunk(4096, std::byte { 0x5a });
+    FIFO fifo;
+    StorageOptions options;
+    options.prefault = true;
+    fifo.SetStorage(options);
+    fifo.Reserve(capacity);
+    auto cycle = [&] {
+        for (std::size_t written = 0; written < capacity; written += chunk.size()) {
+            fifo.Write(chunk);
+            if (fifo.Size() >= capacity / 2) {
+                fifo.Seek(static_cast<std::ptrdiff_t>(fifo.Peek().size()), Position::Absolute);
+                fifo.Clean();
+            }
+        }
+    };
+    // Fault in the code, the stack and the bookkeeping (chunk traces...) used below
+    cycle();
+
+    const auto before = minor_faults();
+    cycle();
+    const auto faults = minor_faults() - before;
+    ASSERT_EQUAL("no page faults touching prefaulted storage", faults, 0L);
+#endif
+    RETURN_TEST("test_fifo_prefault_no_page_faults", 0);
+}
+
+int test_fifo_numa_node() {
+    FIFO missing;
+    StorageOptions unknown;
+    unknown.numa_node = 4096;
+    missing.SetStorage(unknown);
+    ASSERT_EQUAL("unknown node dropped", missing.Storage().numa_node, StorageOptions::AnyNode);
+
+    const std::string message = "placed on a node";
+    for (int node : { StorageOptions::LocalNode, 0 }) {
+        FIFO fifo;
+        fifo.Write(message);
+        StorageOptions options;
+        options.numa_node = node;
+        fifo.SetStorage(options);
+        if constexpr (!StorageOptions::MappingSupported) {
+            ASSERT_EQUAL("dropped without mapping support", fifo.Storage().numa_node, StorageOptions::AnyNode);
+            continue;
+        }
+        // Kernels built without NUMA expose no node at all
+        if (fifo.Storage().numa_node == StorageOptions::AnyNode) continue;
+        ASSERT_EQUAL("node in effect", fifo.Storage().numa_node, node);
+        for (int i = 0; i < 16; ++i) fifo.Write(std::string(4096, 'n'));
+        ASSERT_EQUAL("content kept", StormByte::String::FromByteVector(*fifo.Extract(message.size())), message);
+#if defined(__linux__)
+        if (node == 0) {
+            // Ask the kernel which node backs a written page
+            int placed = -1;
+            auto page = fifo.Peek();
+            if (::syscall(SYS_get_mempolicy, &placed, nullptr, 0UL, page.data(), MPOL_F_NODE | MPOL_F_ADDR) == 0) {
+                ASSERT_EQUAL("page on the requested node", placed, 0);
+            }
+        }
+#endif
+    }
+    RETURN_TEST("test_fifo_numa_node", 0);
+}
+
+int test_fifo_descriptor_transfers() {
+#if defined(__linux__)
+    int fds[2];
+    ASSERT_EQUAL("pipe", ::pipe(fds), 0);
+    FIFO fifo;
+    fifo.Reserve(128);
+    const std::size_t capacity = fifo.Capacity();
+    // Move the head close to the end so the transfers below cross it
+    fifo.Write(std::string(capacity - 20, 'h'));
+    (void)fifo.Extract(capacity - 30);
+
+    const std::string incoming = "scatter read across the end of the ring";
+    ASSERT_EQUAL("write pipe", ::write(fds[1], incoming.data(), incoming.size()), static_cast<ssize_t>(incoming.size()));
+    auto read = fifo.ReadFrom(fds[0], incoming.size());
+    ASSERT_TRUE("read from pipe", read.has_value());
+    ASSERT_EQUAL("all bytes read", *read, incoming.size());
+    ASSERT_EQUAL("no growth", fifo.Capacity(), capacity);
+    ASSERT_EQUAL("stored after the old bytes", fifo.Size(), 10 + incoming.size());
+
+    auto written = fifo.WriteTo(fds[1]);
+    ASSERT_TRUE("write to pipe", written.has_value());
+    ASSERT_EQUAL("gathered in one call", *written, 10 + incoming.size());
+    ASSERT_TRUE("written bytes removed", fifo.Empty());
+    std::string outgoing(10 + incoming.size(), '\0');
+    ASSERT_EQUAL("read pipe", ::read(fds[0], outgoing.data(), outgoing.size()), static_cast<ssize_t>(outgoing.size()));
+    ASSERT_EQUAL("content", outgoing, std::string(10, 'h') + incoming);
+
+    auto empty = fifo.WriteTo(fds[1]);
+    ASSERT_TRUE("nothing to write", empty.has_value() && *empty == 0);
+    ::close(fds[1]);
+    auto eof = fifo.ReadFrom(fds[0]);
+    ASSERT_TRUE("end of file", eof.has_value() && *eof == 0);
+    ::close(fds[0]);
+    auto bad = fifo.ReadFrom(fds[0]);
+    ASSERT_FALSE("closed descriptor reports an error", bad.has_value());
+    fifo.Close();
+    ASSERT_FALSE("closed buffer does not read", fifo.ReadFrom(0).has_value());
+#endif
+    RETURN_TEST("test_fifo_descriptor_transfers", 0);
+}
+
+int test_fifo_map_file() {
+#if defined(__linux__)
+    // Spans more than one readahead window, so pages behind the head are dropped on the way
+    const std::size_t size = 2 * FIFO::MapWindow + 12345;
+    std::string content(size, '\0');
+    for (std::size_t i = 0; i < size; ++i) content[i] = static_cast<char>('a' + (i * 7) % 26);
+    char path[] = "/tmp/stormbyte-map-fileXXXXXX";
+    const int fd = ::mkstemp(path);
+    ASSERT_TRUE("temporary file", fd >= 0);
+    ASSERT_EQUAL("file written", ::write(fd, content.data(), size), static_cast<ssize_t>(size));
+    ::close(fd);
+
+    FIFO fifo;
+    fifo.Write("dropped");
+    auto mapped = fifo.MapFile(path);
+    ASSERT_TRUE("mapped", mapped.has_value());
+    ASSERT_EQUAL("whole file", *mapped, size);
+    ASSERT_EQUAL("size", fifo.Size(), size);
+    ASSERT_FALSE("closed", fifo.IsWritable());
+    ASSERT_FALSE("not at end", fifo.EoF());
+    ASSERT_FALSE("no writes", fifo.Write("more"));
+    ASSERT_TRUE("no acquire", fifo.Acquire(16).empty());
+
+    // Peek views the mapping itself
+    auto whole = fifo.Peek();
+    ASSERT_EQUAL("peek everything", whole.size(), size);
+    ASSERT_TRUE("peek content", std::memcmp(whole.data(), content.data(), size) == 0);
+    ASSERT_TRUE("peek does not move", fifo.Peek(10).data() == whole.data());
+    auto read = fifo.Read(5);
+    ASSERT_EQUAL("read", StormByte::String::FromByteVector(*read), content.substr(0, 5));
+    ASSERT_TRUE("peek follows the read position", fifo.Peek(1).data() == whole.data() + 5);
+    fifo.Clean();
+    ASSERT_EQUAL("clean", fifo.Size(), size - 5);
+
+    for (std::size_t offset = 5; offset < size;) {
+        const std::size_t count = std::min<std::size_t>(1024 * 1024, size - offset);
+        auto chunk = fifo.Extract(count);
+        if (!chunk || chunk->size() != count || std::memcmp(chunk->data(), content.data() + offset, count) != 0) {
+            RETURN_TEST("test_fifo_map_file extract", 1);
+        }
+        offset += count;
+    }
+    ASSERT_TRUE("drained", fifo.Empty() && fifo.EoF());
+    ASSERT_EQUAL("mapping released", fifo.Capacity(), FIFO::InlineCapacity);
+
+    // Moving the storage copies the rest out of the file
+    FIFO copy;
+    ASSERT_TRUE("mapped again", copy.MapFile(path).has_value());
+    (void)copy.Extract(size - 10);
+    copy.ShrinkToFit();
+    ASSERT_EQUAL("moved to regular storage", StormByte::String::FromByteVector(*copy.Extract(0)), content.substr(size - 10));
+    ::unlink(path);
+
+    FIFO failing;
+    failing.Write("kept");
+    ASSERT_FALSE("missing file", failing.MapFile(path).has_value());
+    ASSERT_FALSE("directory", failing.MapFile("/tmp").has_value());
+    ASSERT_EQUAL("failure keeps the content", failing.Size(), static_cast<std::size_t>(4));
+    ASSERT_TRUE("failure keeps the buffer open", failing.IsWritable());
+
+    char empty_path[] = "/tmp/stormbyte-map-emptyXXXXXX";
+    const int empty_fd = ::mkstemp(empty_path);
+    ::close(empty_fd);
+    FIFO empty;
+    auto nothing = empty.MapFile(empty_path);
+    ASSERT_TRUE("empty file", nothing.has_value() && *nothing == 0);
+    ASSERT_TRUE("empty file is at its end", empty.EoF());
+    ::unlink(empty_path);
+#endif
+    RETURN_TEST("test_fifo_map_file", 0);
+}
+
 int main() {
     int result = 0;
     result += test_fifo_write_read_vector();
@@ -673,6 +1178,19 @@ int main() {
 	result += test_fifo_write_after_error();
 	result += test_fifo_read_after_error();
 	result += test_fifo_extract_after_error();
+	result += test_fifo_stats();
+	result += test_fifo_chunk_trace_propagation();
+	result += test_fifo_memory_resource();
+	result += test_fifo_reserve_and_ring_wrap();
+	result += test_fifo_retention_policy();
+	result += test_fifo_inline_storage();
+	result += test_fifo_peek_acquire();
+	result += test_fifo_mirrored_storage();
+	result += test_fifo_storage_options();
+	result += test_fifo_prefault_no_page_faults();
+	result += test_fifo_numa_node();
+	result += test_fifo_descriptor_transfers();
+	result += test_fifo_map_file();
 
     if (result == 0) {
         std::cout << "FIFO tests passed!" << std::endl;
@@ -0,0 +1,152 @@
+#include <StormByte/buffer/histogram.hxx>
+#include <StormByte/buffer/pipeline.hxx>
+#include <StormByte/buffer/producer.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using StormByte::Buffer::Consumer;
+using StormByte::Buffer::ExecutionMode;
+using StormByte::Buffer::HistogramSnapshot;
+using StormByte::Buffer::LatencyHistogram;
+using StormByte::Buffer::Pipeline;
+using StormByte::Buffer::Producer;
+using StormByte::Buffer::Statistics;
+using namespace std::chrono_literals;
+
+int test_histogram_buckets() {
+    for (std::uint64_t v = 0; v < 16; ++v) {
+        ASSERT_EQUAL("exact bucket", LatencyHistogram::BucketIndex(v), static_cast<std::size_t>(v));
+    }
+    for (std::uint64_t v : { 16ull, 17ull, 100ull, 1000ull, 123456ull, 1ull << 30, (1ull << 40) + 12345 }) {
+        const std::size_t index = LatencyHistogram::BucketIndex(v);
+        ASSERT_TRUE("lower bound", LatencyHistogram::BucketLowerBound(index) <= v);
+        ASSERT_TRUE("upper bound", LatencyHistogram::BucketUpperBound(index) >= v);
+        const double width = static_cast<double>(LatencyHistogram::BucketUpperBound(index) - LatencyHistogram::BucketLowerBound(index) + 1);
+        ASSERT_TRUE("relative error", width / static_cast<double>(v) <= 0.125);
+    }
+    for (std::size_t i = 1; i < 200; ++i) {
+        ASSERT_EQUAL("contiguous buckets", LatencyHistogram::BucketLowerBound(i), LatencyHistogram::BucketUpperBound(i - 1) + 1);
+    }
+    ASSERT_EQUAL("saturates", LatencyHistogram::BucketIndex(~0ull), LatencyHistogram::BucketCount - 1);
+    RETURN_TEST("test_histogram_buckets", 0);
+}
+
+int test_histogram_percentiles() {
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 1000; ++i) histogram.Record(std::chrono::nanoseconds(i * 1000));
+    const HistogramSnapshot snapshot = histogram.Snapshot();
+    ASSERT_EQUAL("count", snapshot.count, static_cast<std::uint64_t>(1000));
+    ASSERT_EQUAL("max", snapshot.max, std::chrono::nanoseconds(1000000));
+    ASSERT_EQUAL("mean", snapshot.Mean(), std::chrono::nanoseconds(500500));
+    const auto p50 = snapshot.Percentile(50).count();
+    ASSERT_TRUE("p50 within resolution", p50 >= 500000 && p50 <= 500000 * 1.125);
+    const auto p99 = snapshot.Percentile(99).count();
+    ASSERT_TRUE("p99 within resolution", p99 >= 990000 && p99 <= 1000000);
+    ASSERT_EQUAL("p100 is max", snapshot.Percentile(100), snapshot.max);
+    ASSERT_EQUAL("empty percentile", HistogramSnapshot {}.Percentile(99), std::chrono::nanoseconds(0));
+    RETURN_TEST("test_histogram_percentiles", 0);
+}
+
+int test_histogram_concurrent_record() {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&histogram] {
+            for (int i = 0; i < 10000; ++i) histogram.Record(std::chrono::nanoseconds(i));
+        });
+    }
+    for (auto& t : threads) t.join();
+    ASSERT_EQUAL("no lost updates", histogram.Snapshot().count, static_cast<std::uint64_t>(80000));
+    RETURN_TEST("test_histogram_concurrent_record", 0);
+}
+
+int test_histogram_merge() {
+    LatencyHistogram a, b;
+    a.Record(10ns);
+    b.Record(20ns);
+    b.Record(30ns);
+    HistogramSnapshot merged = a.Snapshot();
+    merged += b.Snapshot();
+    ASSERT_EQUAL("merged count", merged.count, static_cast<std::uint64_t>(3));
+    ASSERT_EQUAL("merged max", merged.max, 30ns);
+    merged -= a.Snapshot();
+    ASSERT_EQUAL("subtracted count", merged.count, static_cast<std::uint64_t>(2));
+    ASSERT_EQUAL("subtracted sum", merged.sum, 50ns);
+    RETURN_TEST("test_histogram_merge", 0);
+}
+
+int test_buffer_wait_histogram() {
+    Producer producer;
+    Consumer consumer = producer.Consumer();
+    std::thread writer([producer]() mutable {
+        std::this_thread::sleep_for(20ms);
+        producer.Write(std::string("data"));
+    });
+    auto data = consumer.Extract(4);
+    writer.join();
+    ASSERT_TRUE("extract ok", data.has_value());
+    auto histogram = consumer.WaitHistogram();
+    if constexpr (Statistics::Enabled) {
+        ASSERT_TRUE("histogram available", histogram != nullptr);
+        const auto snapshot = histogram->Snapshot();
+        ASSERT_EQUAL("one blocked read", snapshot.count, static_cast<std::uint64_t>(1));
+        ASSERT_TRUE("blocked for the sleep", snapshot.max >= 10ms);
+    } else {
+        ASSERT_TRUE("no histogram without stats", histogram == nullptr);
+    }
+    RETURN_TEST("test_buffer_wait_histogram", 0);
+}
+
+int test_pipeline_stage_wait_histograms() {
+    Pipeline pipeline;
+    for (int stage = 0; stage < 2; ++stage) {
+        pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+            while (!in.EoF()) {
+                auto data = in.Extract(4);
+                if (data && !data->empty()) out.Write(*data);
+            }
+            out.Close();
+        });
+    }
+    for (int run = 0; run < 2; ++run) {
+        Producer input;
+        Consumer result = pipeline.Process(input.Consumer(), ExecutionMode::Async, nullptr);
+        std::this_thread::sleep_for(10ms);
+        input.Write(std::string("abcd"));
+        input.Close();
+        auto data = result.Extract(4);
+        ASSERT_TRUE("pipeline output", data.has_value() && data->size() == 4);
+        while (!result.EoF()) std::this_thread::yield();
+    }
+    const auto stages = pipeline.StageWaitHistograms();
+    ASSERT_EQUAL("one histogram per stage", stages.size(), static_cast<std::size_t>(2));
+    if constexpr (Statistics::Enabled) {
+        ASSERT_TRUE("first stage waited in both runs", stages[0].count >= 2);
+        ASSERT_TRUE("first stage waited for input", stages[0].max >= 5ms);
+        ASSERT_TRUE("second stage waited", stages[1].count >= 2);
+    } else {
+        ASSERT_EQUAL("empty without stats", stages[0].count, static_cast<std::uint64_t>(0));
+    }
+    RETURN_TEST("test_pipeline_stage_wait_histograms", 0);
+}
+
+int main() {
+    int result = 0;
+    result += test_histogram_buckets();
+    result += test_histogram_percentiles();
+    result += test_histogram_concurrent_record();
+    result += test_histogram_merge();
+    result += test_buffer_wait_histogram();
+    result += test_pipeline_stage_wait_histograms();
+
+    if (result == 0) {
+        std::cout << "Histogram tests passed!" << std::endl;
+    } else {
+        std::cout << result << " Histogram tests failed." << std::endl;
+    }
+    return result;
+}
@@ -1,13 +1,25 @@
+#include <StormByte/buffer/descriptor.hxx>
 #include <StormByte/buffer/pipeline.hxx>
+#include <StormByte/buffer/registry.hxx>
 #include <StormByte/string.hxx>
 #include <StormByte/test_handlers.h>
 
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <memory_resource>
 #include <string>
 #include <thread>
+#include <vector>
 #include <chrono>
+#include <cstdlib>
 #include <cctype>
 #include <algorithm>
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using StormByte::Buffer::Pipeline;
 using StormByte::Buffer::Producer;
@@ -1125,6 +1137,441 @@ int test_pipeline_interrupted_by_seterror() {
     RETURN_TEST("test_pipeline_interrupted_by_seterror", 0);
 }
 
+int test_pipeline_chunk_trace_end_to_end() {
+    using StormByte::Buffer::ChunkTrace;
+    using StormByte::Buffer::ChunkTracing;
+    Pipeline pipeline;
+    for (int stage = 0; stage < 3; ++stage) {
+        pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+            while (!in.EoF()) {
+                auto data = in.Extract(4);
+                if (data && !data->empty()) out.Write(*data);
+            }
+            out.Close();
+        });
+    }
+    ChunkTracing::Clear();
+    Producer input;
+    Consumer result = pipeline.Process(input.Consumer(), StormByte::Buffer::ExecutionMode::Async, logger);
+    input.Write(std::string("1111"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    input.Write(std::string("2222"));
+    input.Close();
+
+    std::vector<ChunkTrace> traces;
+    while (!result.EoF()) {
+        auto data = result.Extract(4);
+        if (data && !data->empty()) {
+            const auto& last = ChunkTracing::LastExtracted();
+            traces.insert(traces.end(), last.begin(), last.end());
+        }
+    }
+    ChunkTracing::Clear();
+    if constexpr (ChunkTrace::Enabled) {
+        ASSERT_EQUAL("one trace per input chunk", traces.size(), static_cast<std::size_t>(2));
+        ASSERT_TRUE("sequence preserved across stages", traces[0].sequence + 1 == traces[1].sequence);
+        ASSERT_TRUE("ingest order preserved", traces[0].ingest < traces[1].ingest);
+        ASSERT_TRUE("end to end latency measurable", traces[0].Latency() >= traces[1].Latency());
+    } else {
+        ASSERT_TRUE("no traces when disabled", traces.empty());
+    }
+    RETURN_TEST("test_pipeline_chunk_trace_end_to_end", 0);
+}
+
+// Forwards to the default resource, counting allocations
+class CountingResource final: public std::pmr::memory_resource {
+    public:
+        std::atomic<std::size_t> allocations { 0 };
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            allocations++;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+int test_pipeline_memory_resource() {
+    CountingResource resource;
+    std::pmr::synchronized_pool_resource pool(&resource);
+    {
+        Pipeline pipeline(&pool);
+        for (int stage = 0; stage < 2; ++stage) {
+            pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+                while (!in.EoF()) {
+                    auto data = in.Extract(0);
+                    if (data && !data->empty()) out.Write(*data);
+                }
+                out.Close();
+            });
+        }
+        Producer input;
+        input.Write("resource");
+        input.Close();
+        Consumer result = pipeline.Process(input.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+        auto data = result.Extract(0);
+        ASSERT_TRUE("pipeline output", data.has_value());
+        ASSERT_EQUAL("pipeline content", StormByte::String::FromByteVector(*data), std::string("resource"));
+    }
+    ASSERT_TRUE("intermediate buffers allocated from the resource", resource.allocations.load() > 0);
+    RETURN_TEST("test_pipeline_memory_resource", 0);
+}
+
+int test_pipeline_arena() {
+    Pipeline pipeline;
+    pipeline.SetArenaSize(16 * 1024);
+    for (int stage = 0; stage < 3; ++stage) {
+        pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+            while (!in.EoF()) {
+                // Result vectors come from the run's arena as well
+                auto data = in.Extract(0, in.MemoryResource());
+                if (data && !data->empty()) out.Write(std::span<const std::byte>(*data));
+            }
+            out.Close();
+        });
+    }
+    ASSERT_EQUAL("no arena before the first run", pipeline.ArenaBytes(), static_cast<std::size_t>(0));
+
+    std::vector<Consumer> results;
+    for (auto mode : { StormByte::Buffer::ExecutionMode::Async, StormByte::Buffer::ExecutionMode::Sync, StormByte::Buffer::ExecutionMode::Async }) {
+        Producer input;
+        input.Write("arena backed run");
+        input.Close();
+        results.push_back(pipeline.Process(input.Consumer(), mode, logger));
+        if (mode == StormByte::Buffer::ExecutionMode::Sync) {
+            ASSERT_TRUE("arena used by the run", pipeline.ArenaBytes() > 0);
+        }
+    }
+    // Earlier outputs stay valid after their run's arena was released
+    for (auto& result : results) {
+        auto data = result.Extract(16);
+        ASSERT_TRUE("pipeline output", data.has_value());
+        ASSERT_EQUAL("pipeline content", StormByte::String::FromByteVector(*data), std::string("arena backed run"));
+    }
+
+    Pipeline copy(pipeline);
+    Producer empty;
+    empty.Close();
+    auto copy_result = copy.Process(empty.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    ASSERT_TRUE("copy finished", copy_result.EoF());
+    ASSERT_TRUE("copy keeps the arena size", copy.ArenaBytes() > 0);
+    RETURN_TEST("test_pipeline_arena", 0);
+}
+
+int test_pipeline_storage_options() {
+    constexpr std::size_t reserve = 256 * 1024;
+    Pipeline pipeline;
+    StormByte::Buffer::StorageOptions options;
+    options.prefault = true;
+    pipeline.SetStorage(options, reserve);
+    for (int stage = 0; stage < 2; ++stage) {
+        pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+            while (!in.EoF()) {
+                auto data = in.Extract(0);
+                if (data && !data->empty()) out.Write(*data);
+            }
+            out.Close();
+        });
+    }
+
+    // The registry sees the buffers Process() creates
+    StormByte::Buffer::Registry::Enable();
+    Producer input;
+    input.Write("prefaulted run");
+    input.Close();
+    auto output = pipeline.Process(input.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    std::size_t reserved = 0;
+    for (const auto& buffer : StormByte::Buffer::Registry::Instance().Snapshot())
+        if (buffer.capacity >= reserve) ++reserved;
+    StormByte::Buffer::Registry::Enable(false);
+
+    ASSERT_EQUAL("every stage buffer reserved", reserved, static_cast<std::size_t>(2));
+    ASSERT_EQUAL("pipeline content", StormByte::String::FromByteVector(*output.Extract(0)), std::string("prefaulted run"));
+    RETURN_TEST("test_pipeline_storage_options", 0);
+}
+
+int test_pipeline_stage_node() {
+    // Node 0 only exists on NUMA aware kernels
+    StormByte::Buffer::FIFO probe;
+    StormByte::Buffer::StorageOptions options;
+    options.numa_node = 0;
+    probe.SetStorage(options);
+    const bool numa = probe.Storage().numa_node == 0;
+
+    std::atomic<int> first_node { -1 };
+    Pipeline pipeline;
+    pipeline.AddPipe([&first_node](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+#if defined(__linux__)
+        unsigned int cpu = 0, node = 0;
+        if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) first_node = static_cast<int>(node);
+#endif
+        while (!in.EoF()) {
+            auto data = in.Extract(0);
+            if (data && !data->empty()) out.Write(*data);
+        }
+        out.Close();
+    });
+    pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+        while (!in.EoF()) {
+            auto data = in.Extract(0);
+            if (data && !data->empty()) out.Write(*data);
+        }
+        out.Close();
+    });
+    pipeline.SetStageNode(0, 0);
+    // Unknown nodes place nothing
+    pipeline.SetStageNode(1, 4096);
+
+    Producer input;
+    input.Write("numa placed");
+    input.Close();
+    auto output = pipeline.Process(input.Consumer(), StormByte::Buffer::ExecutionMode::Async, logger);
+    auto data = output.Extract(11);
+    ASSERT_TRUE("pipeline output", data.has_value());
+    ASSERT_EQUAL("pipeline content", StormByte::String::FromByteVector(*data), std::string("numa placed"));
+    if (numa) {
+        ASSERT_EQUAL("stage runs on its node", first_node.load(), 0);
+    }
+    RETURN_TEST("test_pipeline_stage_node", 0);
+}
+
+#if defined(__linux__)
+// Sends payload through a socket into the pipeline built by make(input fd, output fd), returns what it wrote to a pipe
+std::string relay_through_descriptors(const std::string& payload, const std::function<Pipeline(int, int)>& make, bool& output_closed) {
+    int input[2], output[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, input) != 0 || ::pipe(output) != 0) return {};
+    std::thread sender([&]() {
+        for (std::size_t sent = 0; sent < payload.size();) {
+            const ssize_t n = ::write(input[0], payload.data() + sent, std::min<std::size_t>(payload.size() - sent, 5000));
+            if (n <= 0) break;
+            sent += static_cast<std::size_t>(n);
+        }
+        ::shutdown(input[0], SHUT_WR);
+    });
+    std::string received;
+    std::thread receiver([&]() {
+        char chunk[4096];
+        ssize_t n;
+        while ((n = ::read(output[0], chunk, sizeof(chunk))) > 0) received.append(chunk, static_cast<std::size_t>(n));
+    });
+
+    Pipeline pipeline = make(input[1], output[1]);
+    Producer unused;
+    unused.Close();
+    auto result = pipeline.Process(unused.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    output_closed = result.EoF() && result.IsReadable();
+    sender.join();
+    ::close(output[1]);
+    receiver.join();
+    ::close(input[0]);
+    ::close(input[1]);
+    ::close(output[0]);
+    return received;
+}
+
+std::string relay_payload() {
+    std::string payload(256 * 1024, '\0');
+    for (std::size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<char>('a' + i % 26);
+    return payload;
+}
+
+void uppercase_stage(Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+    while (true) {
+        auto data = in.Extract(4096);
+        if (!data || data->empty()) break;
+        for (auto& byte : *data) byte = static_cast<std::byte>(std::toupper(static_cast<unsigned char>(byte)));
+        out.Write(*data);
+    }
+    out.Close();
+}
+#endif
+
+int test_pipeline_descriptor_stages() {
+#if defined(__linux__)
+    const std::string payload = relay_payload();
+    bool closed = false;
+    const std::string received = relay_through_descriptors(payload, [](int in, int out) {
+        Pipeline pipeline;
+        pipeline.AddPipe(StormByte::Buffer::DescriptorSource(in));
+        pipeline.AddPipe(uppercase_stage);
+        pipeline.AddPipe(StormByte::Buffer::DescriptorSink(out));
+        return pipeline;
+    }, closed);
+
+    std::string expected = payload;
+    std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    ASSERT_TRUE("sink output closed", closed);
+    ASSERT_EQUAL("bytes through the pipeline", received.size(), expected.size());
+    ASSERT_TRUE("content through the pipeline", received == expected);
+
+    // A failing descriptor turns into an error on the stage output
+    Producer unused;
+    unused.Close();
+    Pipeline failing;
+    failing.AddPipe(StormByte::Buffer::DescriptorSource(-1));
+    auto error = failing.Process(unused.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    ASSERT_FALSE("source error", error.IsReadable());
+#endif
+    RETURN_TEST("test_pipeline_descriptor_stages", 0);
+}
+
+int test_pipeline_splice_stages() {
+#if defined(__linux__)
+    const std::string payload = relay_payload();
+    // Kernel to kernel relay
+    bool closed = false;
+    const std::string relayed = relay_through_descriptors(payload, [](int in, int out) {
+        Pipeline pipeline;
+        pipeline.AddPipe(StormByte::Buffer::SpliceSource(in));
+        pipeline.AddPipe(StormByte::Buffer::SpliceSink(out));
+        return pipeline;
+    }, closed);
+    ASSERT_TRUE("relay output closed", closed);
+    ASSERT_EQUAL("bytes relayed", relayed.size(), payload.size());
+    ASSERT_TRUE("content relayed", relayed == payload);
+
+    // A stage that inspects the bytes takes them back from the kernel transparently
+    const std::string transformed = relay_through_descriptors(payload, [](int in, int out) {
+        Pipeline pipeline;
+        pipeline.AddPipe(StormByte::Buffer::SpliceSource(in));
+        pipeline.AddPipe(uppercase_stage);
+        pipeline.AddPipe(StormByte::Buffer::SpliceSink(out));
+        return pipeline;
+    }, closed);
+    std::string expected = payload;
+    std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    ASSERT_TRUE("transform output closed", closed);
+    ASSERT_EQUAL("bytes transformed", transformed.size(), expected.size());
+    ASSERT_TRUE("content transformed", transformed == expected);
+#endif
+    RETURN_TEST("test_pipeline_splice_stages", 0);
+}
+
+int test_pipeline_uring_stages() {
+#if defined(__linux__)
+    const std::string payload = relay_payload();
+    // Streams: one read and one write in flight at a time
+    bool closed = false;
+    const std::string received = relay_through_descriptors(payload, [](int in, int out) {
+        Pipeline pipeline;
+        pipeline.AddPipe(StormByte::Buffer::UringSource(in));
+        pipeline.AddPipe(uppercase_stage);
+        pipeline.AddPipe(StormByte::Buffer::UringSink(out));
+        return pipeline;
+    }, closed);
+    std::string expected = payload;
+    std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    ASSERT_TRUE("stream output closed", closed);
+    ASSERT_EQUAL("bytes through the streams", received.size(), expected.size());
+    ASSERT_TRUE("content through the streams", received == expected);
+
+    // Files: small blocks keep several reads and writes in flight at explicit offsets
+    char source_path[] = "/tmp/stormbyte-uring-sourceXXXXXX";
+    char sink_path[] = "/tmp/stormbyte-uring-sinkXXXXXX";
+    const int source = ::mkstemp(source_path);
+    const int sink = ::mkstemp(sink_path);
+    ASSERT_TRUE("temporary files", source >= 0 && sink >= 0);
+    const std::string file_payload = payload.substr(0, payload.size() - 1000);
+    ASSERT_EQUAL("source written", ::write(source, file_payload.data(), file_payload.size()), static_cast<ssize_t>(file_payload.size()));
+    ::lseek(source, 0, SEEK_SET);
+    Pipeline copy;
+    copy.AddPipe(StormByte::Buffer::UringSource(source, 8, 4096));
+    copy.AddPipe(StormByte::Buffer::UringSink(sink, 8, 4096));
+    Producer unused;
+    unused.Close();
+    auto result = copy.Process(unused.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    ASSERT_TRUE("copy output closed", result.EoF() && result.IsReadable());
+    ASSERT_EQUAL("source position at its end", ::lseek(source, 0, SEEK_CUR), static_cast<off_t>(file_payload.size()));
+    ASSERT_EQUAL("sink position at its end", ::lseek(sink, 0, SEEK_CUR), static_cast<off_t>(file_payload.size()));
+    std::string copied(file_payload.size() + 1, '\0');
+    ASSERT_EQUAL("sink size", ::pread(sink, copied.data(), copied.size(), 0), static_cast<ssize_t>(file_payload.size()));
+    copied.resize(file_payload.size());
+    ASSERT_TRUE("file copied in order", copied == file_payload);
+    // A second run reuses the ring and blocks of each stage
+    ::lseek(source, 0, SEEK_SET);
+    ::lseek(sink, 0, SEEK_SET);
+    ::ftruncate(sink, 0);
+    result = copy.Process(unused.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    ASSERT_TRUE("second copy output closed", result.EoF() && result.IsReadable());
+    copied.assign(file_payload.size() + 1, '\0');
+    ASSERT_EQUAL("second sink size", ::pread(sink, copied.data(), copied.size(), 0), static_cast<ssize_t>(file_payload.size()));
+    copied.resize(file_payload.size());
+    ASSERT_TRUE("file copied again", copied == file_payload);
+    ::close(source);
+    ::close(sink);
+    ::unlink(source_path);
+    ::unlink(sink_path);
+
+    // A failing descriptor turns into an error on the stage output
+    Pipeline failing;
+    failing.AddPipe(StormByte::Buffer::UringSource(-1));
+    auto error = failing.Process(unused.Consumer(), StormByte::Buffer::ExecutionMode::Sync, logger);
+    ASSERT_FALSE("source error", error.IsReadable());
+#endif
+    RETURN_TEST("test_pipeline_uring_stages", 0);
+}
+
+int test_pipeline_mapped_file_input() {
+#if defined(__linux__)
+    const std::string payload = relay_payload();
+    char path[] = "/tmp/stormbyte-mapped-inputXXXXXX";
+    const int fd = ::mkstemp(path);
+    ASSERT_TRUE("temporary file", fd >= 0);
+    ASSERT_EQUAL("file written", ::write(fd, payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    ::close(fd);
+
+    auto input = Consumer::MapFile(path);
+    ASSERT_TRUE("file mapped", input.has_value());
+    ASSERT_EQUAL("whole file visible", input->AvailableBytes(), payload.size());
+    ASSERT_TRUE("input closed", !input->IsWritable());
+    ASSERT_TRUE("peek from the mapping", input->Peek(4).data() == input->Peek(8).data());
+
+    Pipeline pipeline;
+    pipeline.AddPipe(uppercase_stage);
+    Consumer result = pipeline.Process(*input, StormByte::Buffer::ExecutionMode::Async, logger);
+    wait_for_pipeline_completion(result);
+    auto data = CONSUME(result, 0);
+    std::string expected = payload;
+    std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    ASSERT_TRUE("output read", data.has_value());
+    ASSERT_TRUE("content through the pipeline", StormByte::String::FromByteVector(*data) == expected);
+    ::unlink(path);
+
+    ASSERT_FALSE("missing file", Consumer::MapFile(path).has_value());
+#endif
+    RETURN_TEST("test_pipeline_mapped_file_input", 0);
+}
+
+int test_pipeline_spill() {
+#if defined(__linux__)
+    const std::string payload = relay_payload();
+    Pipeline pipeline;
+    pipeline.SetSpill({ 4096, 1024, {} });
+    // The output is only read once the run is over, so most of it waits on disk
+    pipeline.AddPipe(uppercase_stage);
+
+    Producer input;
+    input.Write(payload);
+    input.Close();
+    Consumer result = pipeline.Process(input.Consumer(), StormByte::Buffer::ExecutionMode::Async, logger);
+    wait_for_pipeline_completion(result);
+    // Spilled bytes come back a bounded part at a time
+    std::string output;
+    while (!result.EoF()) {
+        auto data = CONSUME(result, 0);
+        ASSERT_TRUE("output read", data.has_value() && !data->empty());
+        output += StormByte::String::FromByteVector(*data);
+    }
+    std::string expected = payload;
+    std::transform(expected.begin(), expected.end(), expected.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    ASSERT_TRUE("content through spilled buffers", output == expected);
+#endif
+    RETURN_TEST("test_pipeline_spill", 0);
+}
+
 int main() {
     int result = 0;
     result += test_pipeline_empty();
@@ -1147,6 +1594,16 @@ int main() {
     result += test_pipeline_large_concurrent_stress();
     result += test_pipeline_sync_execution();
     result += test_pipeline_interrupted_by_seterror();
+    result += test_pipeline_chunk_trace_end_to_end();
+    result += test_pipeline_memory_resource();
+    result += test_pipeline_arena();
+    result += test_pipeline_storage_options();
+    result += test_pipeline_stage_node();
+    result += test_pipeline_descriptor_stages();
+    result += test_pipeline_splice_stages();
+    result += test_pipeline_uring_stages();
+    result += test_pipeline_mapped_file_input();
+    result += test_pipeline_spill();
 
     if (result == 0) {
         std::cout << "Pipeline tests passed!" << std::endl;
@@ -0,0 +1,112 @@
+#include <StormByte/buffer/prometheus_exporter.hxx>
+#include <StormByte/buffer/producer.hxx>
+#include <StormByte/buffer/registry.hxx>
+#include <StormByte/buffer/shared_fifo.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using StormByte::Buffer::Consumer;
+using StormByte::Buffer::Producer;
+using StormByte::Buffer::PrometheusExporter;
+using StormByte::Buffer::Registry;
+using StormByte::Buffer::SharedFIFO;
+
+int test_registry_disabled_by_default() {
+    ASSERT_FALSE("disabled by default", Registry::IsEnabled());
+    SharedFIFO fifo;
+    ASSERT_EQUAL("not registered while disabled", Registry::Instance().Count(), static_cast<std::size_t>(0));
+    RETURN_TEST("test_registry_disabled_by_default", 0);
+}
+
+int test_registry_register_unregister() {
+    Registry::Enable();
+    {
+        SharedFIFO a;
+        auto b = std::make_unique<SharedFIFO>();
+        ASSERT_EQUAL("two registered", Registry::Instance().Count(), static_cast<std::size_t>(2));
+        b.reset();
+        ASSERT_EQUAL("one left after destruction", Registry::Instance().Count(), static_cast<std::size_t>(1));
+    }
+    ASSERT_EQUAL("none left", Registry::Instance().Count(), static_cast<std::size_t>(0));
+    Registry::Enable(false);
+    RETURN_TEST("test_registry_register_unregister", 0);
+}
+
+int test_registry_snapshot_state() {
+    Registry::Enable();
+    Producer producer;
+    Consumer consumer = producer.Consumer();
+    producer.Write(std::string("0123456789"));
+    (void)consumer.Read(4);
+
+    std::thread waiter([consumer]() mutable {
+        (void)consumer.Extract(64); // blocks until closed
+    });
+    // Wait until the reader is blocked
+    for (int i = 0; i < 1000; ++i) {
+        auto snapshots = Registry::Instance().Snapshot();
+        if (!snapshots.empty() && snapshots.front().waiters == 1) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto snapshots = Registry::Instance().Snapshot();
+    ASSERT_EQUAL("one buffer", snapshots.size(), static_cast<std::size_t>(1));
+    const auto& s = snapshots.front();
+    ASSERT_EQUAL("size", s.size, static_cast<std::size_t>(10));
+    ASSERT_TRUE("capacity covers size", s.capacity >= s.size);
+    ASSERT_EQUAL("available", s.available, static_cast<std::size_t>(6));
+    ASSERT_EQUAL("one waiter", s.waiters, static_cast<std::size_t>(1));
+    ASSERT_FALSE("open", s.closed);
+
+    producer.Close();
+    waiter.join();
+    snapshots = Registry::Instance().Snapshot();
+    ASSERT_TRUE("closed reported", snapshots.front().closed);
+    ASSERT_EQUAL("no waiters after close", snapshots.front().waiters, static_cast<std::size_t>(0));
+    Registry::Enable(false);
+    RETURN_TEST("test_registry_snapshot_state", 0);
+}
+
+int test_prometheus_render() {
+    Registry::Enable();
+    SharedFIFO fifo;
+    fifo.Write(std::string("abc"));
+    const std::string text = PrometheusExporter::Render();
+    ASSERT_TRUE("count gauge", text.find("stormbyte_buffer_count 1\n") != std::string::npos);
+    ASSERT_TRUE("size sum", text.find("stormbyte_buffer_size_bytes_sum 3\n") != std::string::npos);
+    ASSERT_TRUE("type line", text.find("# TYPE stormbyte_buffer_size_bytes gauge\n") != std::string::npos);
+    ASSERT_TRUE("per buffer sample", text.find("stormbyte_buffer_size_bytes{id=\"") != std::string::npos);
+
+    const auto path = std::filesystem::temp_directory_path() / "stormbyte_buffer_registry_test.prom";
+    ASSERT_TRUE("write file", PrometheusExporter::Write(path, "custom"));
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    ASSERT_TRUE("custom prefix in file", content.str().find("custom_count 1\n") != std::string::npos);
+    std::filesystem::remove(path);
+    Registry::Enable(false);
+    RETURN_TEST("test_prometheus_render", 0);
+}
+
+int main() {
+    int result = 0;
+    result += test_registry_disabled_by_default();
+    result += test_registry_register_unregister();
+    result += test_registry_snapshot_state();
+    result += test_prometheus_render();
+
+    if (result == 0) {
+        std::cout << "Registry tests passed!" << std::endl;
+    } else {
+        std::cout << result << " Registry tests failed." << std::endl;
+    }
+    return result;
+}
@@ -5,9 +5,21 @@
 #include <thread>
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
 
 using StormByte::Buffer::SharedFIFO;
 using StormByte::Buffer::Position;
@@ -436,6 +448,453 @@ int test_shared_fifo_extract_closed_no_data_nonblocking() {
     RETURN_TEST("test_shared_fifo_extract_closed_no_data_nonblocking", 0);
 }
 
+int test_shared_fifo_stats_waits() {
+    SharedFIFO fifo;
+    std::thread writer([&]() -> void {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        fifo.Write(std::string("1234"));
+    });
+    auto data = fifo.Extract(4); // blocks until the writer delivers
+    writer.join();
+    ASSERT_EQUAL("extracted", toString(*data), std::string("1234"));
+
+    const auto stats = fifo.Stats();
+    if constexpr (StormByte::Buffer::Statistics::Enabled) {
+        ASSERT_EQUAL("waits", stats.waits, static_cast<std::size_t>(1));
+        ASSERT_TRUE("wait time recorded", stats.wait_time.count() > 0);
+        ASSERT_EQUAL("notifies", stats.notifies, static_cast<std::size_t>(1));
+        ASSERT_EQUAL("bytes extracted", stats.bytes_extracted, static_cast<std::size_t>(4));
+    } else {
+        ASSERT_EQUAL("stats disabled waits", stats.waits, static_cast<std::size_t>(0));
+    }
+    RETURN_TEST("test_shared_fifo_stats_waits", 0);
+}
+
+int test_shared_fifo_reserve_steady_capacity() {
+    SharedFIFO fifo;
+    fifo.Reserve(4096);
+    StormByte::Buffer::RetentionPolicy policy;
+    policy.max_spare = 0;
+    fifo.SetRetention(policy);
+    ASSERT_EQUAL("policy stored", fifo.Retention().max_spare, static_cast<std::size_t>(0));
+
+    const std::string chunk(64, 'c');
+    std::thread writer([&]() -> void {
+        for (int i = 0; i < 32; ++i) fifo.Write(chunk);
+        fifo.Close();
+    });
+    std::size_t total = 0;
+    while (!fifo.EoF()) {
+        auto data = fifo.Extract(64);
+        if (data) total += data->size();
+    }
+    writer.join();
+    ASSERT_EQUAL("all bytes", total, static_cast<std::size_t>(32 * 64));
+    // Never more than 2 KiB in flight: the reserved storage was enough and is kept
+    ASSERT_EQUAL("reserved capacity kept", fifo.Capacity(), static_cast<std::size_t>(4096));
+    fifo.ShrinkToFit();
+    ASSERT_EQUAL("shrink to fit", fifo.Capacity(), SharedFIFO::InlineCapacity);
+    RETURN_TEST("test_shared_fifo_reserve_steady_capacity", 0);
+}
+
+int test_shared_fifo_commit_wakes_reader() {
+    SharedFIFO fifo;
+    StormByte::Buffer::StorageOptions options;
+    options.mirrored = StormByte::Buffer::StorageOptions::MappingSupported;
+    fifo.SetStorage(options);
+
+    std::thread writer([&]() -> void {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto space = fifo.Acquire(5);
+        std::memcpy(space.data(), "hello", 5);
+        fifo.Commit(5);
+    });
+    // Blocks until the committed bytes arrive
+    auto data = fifo.Extract(5);
+    writer.join();
+    ASSERT_TRUE("extract", data.has_value());
+    ASSERT_EQUAL("committed bytes", StormByte::String::FromByteVector(*data), std::string("hello"));
+    RETURN_TEST("test_shared_fifo_commit_wakes_reader", 0);
+}
+
+int test_shared_fifo_read_from_does_not_block_readers() {
+#if defined(__linux__)
+    int fds[2];
+    ASSERT_EQUAL("pipe", ::pipe(fds), 0);
+    SharedFIFO fifo;
+    fifo.Write(std::string("queued"));
+
+    // Waits for the empty pipe without holding the buffer lock
+    std::thread source([&]() -> void { (void)fifo.ReadFrom(fds[0]); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto queued = fifo.Extract(6);
+    ASSERT_TRUE("extract while the source waits", queued.has_value());
+    ASSERT_EQUAL("queued bytes", StormByte::String::FromByteVector(*queued), std::string("queued"));
+
+    ASSERT_EQUAL("write pipe", ::write(fds[1], "piped", 5), static_cast<ssize_t>(5));
+    auto piped = fifo.Extract(5);
+    source.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+    ASSERT_TRUE("extract", piped.has_value());
+    ASSERT_EQUAL("piped bytes", StormByte::String::FromByteVector(*piped), std::string("piped"));
+#endif
+    RETURN_TEST("test_shared_fifo_read_from_does_not_block_readers", 0);
+}
+
+#if defined(__linux__)
+// Fill a pipe until a write would block, leaving its write end blocking; returns the bytes it holds
+static std::size_t fill_pipe(int fd) {
+    const int flags = ::fcntl(fd, F_GETFL);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    const std::string filler(4096, 'f');
+    std::size_t filled = 0;
+    while (true) {
+        const ssize_t result = ::write(fd, filler.data(), filler.size());
+        if (result <= 0) break;
+        filled += static_cast<std::size_t>(result);
+    }
+    ::fcntl(fd, F_SETFL, flags);
+    return filled;
+}
+
+// Read exactly size bytes from a pipe
+static std::string drain_pipe(int fd, std::size_t size) {
+    std::string data(size, '\0');
+    std::size_t done = 0;
+    while (done < size) {
+        const ssize_t result = ::read(fd, data.data() + done, size - done);
+        if (result <= 0) break;
+        done += static_cast<std::size_t>(result);
+    }
+    data.resize(done);
+    return data;
+}
+
+// Run f in a thread and tell whether it finished within a second; join it with the returned thread
+template<class Function>
+static bool finishes_in_time(Function f, std::thread& thread) {
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    thread = std::thread([f, done] {
+        f();
+        *done = true;
+    });
+    for (int i = 0; i < 100 && !*done; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return *done;
+}
+#endif
+
+int test_shared_fifo_write_to_does_not_block_writers() {
+#if defined(__linux__)
+    int sink[2];
+    ASSERT_EQUAL("pipe", ::pipe(sink), 0);
+    const std::size_t filled = fill_pipe(sink[1]);
+    auto fifo = std::make_shared<SharedFIFO>();
+    fifo->Write(std::string("stalled"));
+
+    // Waits for room in the full pipe without holding the buffer lock
+    std::thread relay([fifo, fd = sink[1]] {
+        std::size_t sent = 0;
+        while (sent < 12) {
+            auto result = fifo->WriteTo(fd);
+            if (!result || *result == 0) break;
+            sent += *result;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread writer;
+    const bool in_time = finishes_in_time([fifo] {
+        fifo->Write(std::string(":more"));
+        (void)fifo->Size();
+    }, writer);
+    // Room again: the relay goes on, and a writer held back by it can finish
+    const std::string filler = drain_pipe(sink[0], filled);
+    writer.join();
+    const std::string relayed = drain_pipe(sink[0], 12);
+    relay.join();
+    ::close(sink[0]);
+    ::close(sink[1]);
+    ASSERT_TRUE("write while the sink is full", in_time);
+    ASSERT_EQUAL("filler untouched", filler.size(), filled);
+    ASSERT_EQUAL("relayed after the stall", relayed, std::string("stalled:more"));
+#endif
+    RETURN_TEST("test_shared_fifo_write_to_does_not_block_writers", 0);
+}
+
+int test_shared_fifo_write_to_without_nowait_does_not_block_writers() {
+#if defined(__linux__)
+    // A terminal refuses RWF_NOWAIT: once it reports room, a large write may still wait for its reader
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0) RETURN_TEST("test_shared_fifo_write_to_without_nowait_does_not_block_writers", 0);
+    ASSERT_TRUE("pty", ::grantpt(master) == 0 && ::unlockpt(master) == 0);
+    const int slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+    ASSERT_TRUE("open pty", slave >= 0);
+    termios mode;
+    ::tcgetattr(slave, &mode);
+    ::cfmakeraw(&mode);
+    ::tcsetattr(slave, TCSANOW, &mode);
+    // Nearly full: room for a little, far less than the buffer holds
+    const std::size_t filled = fill_pipe(slave);
+    const std::string filler = drain_pipe(master, 4096);
+    const std::string payload(256 * 1024, 'p');
+    auto fifo = std::make_shared<SharedFIFO>();
+    fifo->Write(payload);
+
+    std::thread relay([fifo, fd = slave, total = payload.size() + 5] {
+        std::size_t sent = 0;
+        while (sent < total) {
+            auto result = fifo->WriteTo(fd);
+            if (!result || *result == 0) break;
+            sent += *result;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread writer;
+    const bool in_time = finishes_in_time([fifo] {
+        fifo->Write(std::string(":more"));
+        (void)fifo->Size();
+    }, writer);
+    // Drain before joining: a relay writing under the lock only finishes once read
+    const std::string rest = drain_pipe(master, filled - filler.size());
+    const std::string relayed = drain_pipe(master, payload.size() + 5);
+    writer.join();
+    relay.join();
+    ::close(slave);
+    ::close(master);
+    ASSERT_TRUE("write while the sink is nearly full", in_time);
+    ASSERT_EQUAL("filler untouched", filler.size() + rest.size(), filled);
+    ASSERT_TRUE("relayed after the stall", relayed == payload + ":more");
+#endif
+    RETURN_TEST("test_shared_fifo_write_to_without_nowait_does_not_block_writers", 0);
+}
+
+int test_shared_fifo_splice() {
+#if defined(__linux__)
+    int source[2], sink[2];
+    ASSERT_EQUAL("source pipe", ::pipe(source), 0);
+    ASSERT_EQUAL("sink pipe", ::pipe(sink), 0);
+    auto feed = [&](const std::string& text) { return ::write(source[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()); };
+
+    // Relayed bytes stay in the kernel: the storage never grows past its inline part
+    SharedFIFO fifo;
+    const std::string body(16 * 1024, 'k');
+    ASSERT_TRUE("feed", feed(body));
+    auto in = fifo.SpliceFrom(source[0]);
+    ASSERT_TRUE("splice in", in.has_value() && *in == body.size());
+    ASSERT_EQUAL("kernel bytes counted", fifo.Size(), body.size());
+    ASSERT_EQUAL("kernel bytes available", fifo.AvailableBytes(), body.size());
+    auto out = fifo.SpliceTo(sink[1]);
+    ASSERT_TRUE("splice out", out.has_value() && *out == body.size());
+    ASSERT_TRUE("drained", fifo.Empty());
+    ASSERT_EQUAL("storage untouched", fifo.Capacity(), SharedFIFO::InlineCapacity);
+    std::string relayed(body.size(), '\0');
+    ASSERT_EQUAL("read sink", ::read(sink[0], relayed.data(), relayed.size()), static_cast<ssize_t>(body.size()));
+    ASSERT_TRUE("relayed content", relayed == body);
+
+    // Written and spliced bytes keep their order whichever path they take
+    fifo.Write(std::string("head:"));
+    ASSERT_TRUE("feed", feed("spliced"));
+    (void)fifo.SpliceFrom(source[0]);
+    fifo.Write(std::string(":tail"));
+    auto all = fifo.Extract(0);
+    ASSERT_TRUE("extract", all.has_value());
+    ASSERT_EQUAL("ordered content", StormByte::String::FromByteVector(*all), std::string("head:spliced:tail"));
+
+    // Stored bytes leave before the kernel held ones
+    fifo.Write(std::string("first,"));
+    ASSERT_TRUE("feed", feed("second"));
+    (void)fifo.SpliceFrom(source[0]);
+    fifo.Close();
+    std::string sent;
+    while (true) {
+        auto moved = fifo.SpliceTo(sink[1]);
+        if (!moved || *moved == 0) break;
+        std::string chunk(*moved, '\0');
+        (void)::read(sink[0], chunk.data(), chunk.size());
+        sent += chunk;
+    }
+    ASSERT_EQUAL("ordered output", sent, std::string("first,second"));
+    ASSERT_TRUE("end of file", fifo.EoF());
+    for (int fd : { source[0], source[1], sink[0], sink[1] }) ::close(fd);
+#endif
+    RETURN_TEST("test_shared_fifo_splice", 0);
+}
+
+int test_shared_fifo_splice_to_does_not_block_writers() {
+#if defined(__linux__)
+    int source[2], sink[2];
+    ASSERT_EQUAL("source pipe", ::pipe(source), 0);
+    // A socket ignores SPLICE_F_NONBLOCK: only waiting without the lock keeps writers going
+    ASSERT_EQUAL("sink socket", ::socketpair(AF_UNIX, SOCK_STREAM, 0, sink), 0);
+    const std::size_t filled = fill_pipe(sink[1]);
+    auto fifo = std::make_shared<SharedFIFO>();
+    ASSERT_EQUAL("feed", ::write(source[1], "stalled", 7), static_cast<ssize_t>(7));
+    auto in = fifo->SpliceFrom(source[0]);
+    ASSERT_TRUE("splice in", in.has_value() && *in == 7);
+
+    std::thread relay([fifo, fd = sink[1]] {
+        std::size_t sent = 0;
+        while (sent < 12) {
+            auto result = fifo->SpliceTo(fd);
+            if (!result || *result == 0) break;
+            sent += *result;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread writer;
+    const bool in_time = finishes_in_time([fifo] {
+        fifo->Write(std::string(":more"));
+        (void)fifo->Size();
+    }, writer);
+    const std::string filler = drain_pipe(sink[0], filled);
+    writer.join();
+    const std::string relayed = drain_pipe(sink[0], 12);
+    relay.join();
+    for (int fd : { source[0], source[1], sink[0], sink[1] }) ::close(fd);
+    ASSERT_TRUE("write while the sink is full", in_time);
+    ASSERT_EQUAL("filler untouched", filler.size(), filled);
+    ASSERT_EQUAL("relayed after the stall", relayed, std::string("stalled:more"));
+#endif
+    RETURN_TEST("test_shared_fifo_splice_to_does_not_block_writers", 0);
+}
+
+int test_shared_fifo_spill() {
+#if defined(__linux__)
+    auto pattern = [](std::size_t offset, std::size_t size) {
+        std::string text(size, '\0');
+        for (std::size_t i = 0; i < size; ++i) text[i] = static_cast<char>('a' + (offset + i) % 23);
+        return text;
+    };
+
+    // Below the threshold nothing touches the disk
+    SharedFIFO fifo;
+    fifo.SetSpill({ 16 * 1024, 4096, "/tmp" });
+    ASSERT_EQUAL("policy in effect", fifo.Spill().threshold, static_cast<std::size_t>(16 * 1024));
+    fifo.Write(pattern(0, 8 * 1024));
+    ASSERT_EQUAL("nothing spilled", fifo.SpilledBytes(), static_cast<std::size_t>(0));
+
+    // Past it, bytes go to the file and still count as stored
+    for (std::size_t offset = 8 * 1024; offset < 256 * 1024; offset += 1000)
+        fifo.Write(pattern(offset, std::min<std::size_t>(1000, 256 * 1024 - offset)));
+    ASSERT_EQUAL("size", fifo.Size(), static_cast<std::size_t>(256 * 1024));
+    ASSERT_EQUAL("available", fifo.AvailableBytes(), static_cast<std::size_t>(256 * 1024));
+    ASSERT_EQUAL("spilled", fifo.SpilledBytes(), static_cast<std::size_t>(240 * 1024));
+    ASSERT_TRUE("memory bounded", fifo.Capacity() <= 64 * 1024);
+
+    // Reads past the bytes in memory page the file back in order
+    auto read = fifo.Read(20 * 1024);
+    ASSERT_TRUE("read across the threshold", read.has_value() && StormByte::String::FromByteVector(*read) == pattern(0, 20 * 1024));
+    fifo.Seek(100 * 1024, StormByte::Buffer::Position::Absolute);
+    read = fifo.Read(10);
+    ASSERT_TRUE("seek into the file", read.has_value() && StormByte::String::FromByteVector(*read) == pattern(100 * 1024, 10));
+    fifo.Seek(0, StormByte::Buffer::Position::Absolute);
+
+    // Commit and the descriptor path spill like Write()
+    auto space = fifo.Acquire(100);
+    std::memcpy(space.data(), pattern(256 * 1024, 100).data(), 100);
+    ASSERT_TRUE("commit", fifo.Commit(100));
+    int source[2];
+    ASSERT_EQUAL("pipe", ::pipe(source), 0);
+    const std::string piped = pattern(256 * 1024 + 100, 900);
+    ASSERT_EQUAL("feed", ::write(source[1], piped.data(), piped.size()), static_cast<ssize_t>(piped.size()));
+    ::close(source[1]);
+    auto received = fifo.ReadFrom(source[0], piped.size());
+    ASSERT_TRUE("read from", received.has_value() && *received == piped.size());
+    ::close(source[0]);
+    fifo.Close();
+
+    // The consumer sees every byte once and in order
+    std::string extracted;
+    while (!fifo.EoF()) {
+        auto chunk = fifo.Extract(3000);
+        if (!chunk) break;
+        extracted += StormByte::String::FromByteVector(*chunk);
+    }
+    ASSERT_EQUAL("extracted size", extracted.size(), static_cast<std::size_t>(256 * 1024 + 1000));
+    ASSERT_TRUE("extracted content", extracted == pattern(0, 256 * 1024 + 1000));
+    ASSERT_EQUAL("file drained", fifo.SpilledBytes(), static_cast<std::size_t>(0));
+
+    // A producer far ahead of its reader
+    SharedFIFO relay;
+    relay.SetSpill({ 8 * 1024, 2048, {} });
+    const std::size_t total = 2 * 1024 * 1024;
+    std::thread producer([&] {
+        for (std::size_t offset = 0; offset < total; offset += 4096) relay.Write(pattern(offset, 4096));
+        relay.Close();
+    });
+    std::string relayed;
+    while (true) {
+        auto chunk = relay.Extract(5000);
+        if (!chunk || chunk->empty()) break;
+        relayed += StormByte::String::FromByteVector(*chunk);
+    }
+    producer.join();
+    ASSERT_TRUE("relayed content", relayed == pattern(0, total));
+
+    // Asking for everything brings a bounded part back, not the whole file
+    SharedFIFO backlog;
+    backlog.SetSpill({ 4096, 1024, {} });
+    for (std::size_t offset = 0; offset < 64 * 1024; offset += 1024) backlog.Write(pattern(offset, 1024));
+    backlog.Close();
+    std::string whole;
+    while (!backlog.EoF()) {
+        auto chunk = backlog.Extract(0);
+        ASSERT_TRUE("part extracted", chunk.has_value() && !chunk->empty());
+        ASSERT_TRUE("part bounded", chunk->size() <= 4096 + 1024);
+        whole += StormByte::String::FromByteVector(*chunk);
+    }
+    ASSERT_TRUE("parts in order", whole == pattern(0, 64 * 1024));
+
+    // Clear() drops the file content as well
+    SharedFIFO cleared;
+    cleared.SetSpill({ 1024, 1024, {} });
+    cleared.Write(pattern(0, 10 * 1024));
+    ASSERT_TRUE("spilled before clear", cleared.SpilledBytes() > 0);
+    cleared.Clear();
+    ASSERT_TRUE("cleared", cleared.Empty() && cleared.SpilledBytes() == 0);
+    cleared.Write(std::string("fresh"));
+    auto fresh = cleared.Extract(0);
+    ASSERT_EQUAL("reused after clear", StormByte::String::FromByteVector(*fresh), std::string("fresh"));
+
+    // Nowhere to spill: everything stays in memory and the policy is dropped
+    SharedFIFO nowhere;
+    nowhere.SetSpill({ 1024, 1024, "/nonexistent/stormbyte" });
+    nowhere.Write(pattern(0, 4096));
+    ASSERT_EQUAL("kept in memory", nowhere.SpilledBytes(), static_cast<std::size_t>(0));
+    ASSERT_EQUAL("policy dropped", nowhere.Spill().threshold, static_cast<std::size_t>(0));
+    auto kept = nowhere.Extract(0);
+    ASSERT_TRUE("kept content", kept.has_value() && StormByte::String::FromByteVector(*kept) == pattern(0, 4096));
+#endif
+    RETURN_TEST("test_shared_fifo_spill", 0);
+}
+
+int test_shared_fifo_spill_write_failure() {
+#if defined(__linux__)
+    SharedFIFO fifo;
+    fifo.SetSpill({ 1024, 1024, {} });
+    ASSERT_TRUE("first spill", fifo.Write(std::string(4096, 'a')));
+    const std::size_t spilled = fifo.SpilledBytes();
+    ASSERT_TRUE("spilled", spilled > 0);
+
+    // The file cannot grow any more, as on a full disk
+    rlimit previous;
+    ASSERT_EQUAL("get limit", ::getrlimit(RLIMIT_FSIZE, &previous), 0);
+    void (*handler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit limit = previous;
+    limit.rlim_cur = spilled;
+    ASSERT_EQUAL("set limit", ::setrlimit(RLIMIT_FSIZE, &limit), 0);
+    const bool written = fifo.Write(std::string(4096, 'b'));
+    ::setrlimit(RLIMIT_FSIZE, &previous);
+    std::signal(SIGXFSZ, handler);
+
+    // Keeping the bytes in memory would put them before the spilled ones: refused
+    ASSERT_FALSE("write refused", written);
+    ASSERT_FALSE("buffer in error", fifo.IsWritable());
+    ASSERT_EQUAL("nothing added", fifo.Size(), static_cast<std::size_t>(4096));
+#endif
+    RETURN_TEST("test_shared_fifo_spill_write_failure", 0);
+}
+
 int main() {
     int result = 0;
     result += test_shared_fifo_producer_consumer_blocking();
@@ -454,6 +913,16 @@ int main() {
     result += test_shared_fifo_available_bytes_concurrent();
     result += test_shared_fifo_read_closed_no_data_nonblocking();
     result += test_shared_fifo_extract_closed_no_data_nonblocking();
+    result += test_shared_fifo_stats_waits();
+    result += test_shared_fifo_reserve_steady_capacity();
+    result += test_shared_fifo_commit_wakes_reader();
+    result += test_shared_fifo_read_from_does_not_block_readers();
+    result += test_shared_fifo_write_to_does_not_block_writers();
+    result += test_shared_fifo_write_to_without_nowait_does_not_block_writers();
+    result += test_shared_fifo_splice();
+    result += test_shared_fifo_splice_to_does_not_block_writers();
+    result += test_shared_fifo_spill();
+    result += test_shared_fifo_spill_write_failure();
 
     if (result == 0) {
         std::cout << "SharedFIFO tests passed!" << std::endl;
@@ -0,0 +1,108 @@
+#include <StormByte/buffer/fifo.hxx>
+#include <StormByte/buffer/pipeline.hxx>
+#include <StormByte/buffer/slab_pool.hxx>
+#include <StormByte/string.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using StormByte::Buffer::Consumer;
+using StormByte::Buffer::ExecutionMode;
+using StormByte::Buffer::FIFO;
+using StormByte::Buffer::Pipeline;
+using StormByte::Buffer::Producer;
+using StormByte::Buffer::SlabPool;
+
+int test_slab_pool_size_classes() {
+    ASSERT_EQUAL("minimum class", SlabPool::BlockSize(1), SlabPool::MinBlock);
+    ASSERT_EQUAL("exact class", SlabPool::BlockSize(512), static_cast<std::size_t>(512));
+    ASSERT_EQUAL("rounded up", SlabPool::BlockSize(513), static_cast<std::size_t>(1024));
+    ASSERT_EQUAL("largest class", SlabPool::BlockSize(SlabPool::MaxBlock), SlabPool::MaxBlock);
+    ASSERT_EQUAL("too large", SlabPool::BlockSize(SlabPool::MaxBlock + 1), static_cast<std::size_t>(0));
+    ASSERT_EQUAL("over aligned", SlabPool::BlockSize(64, 128), static_cast<std::size_t>(0));
+    RETURN_TEST("test_slab_pool_size_classes", 0);
+}
+
+int test_slab_pool_magazine_reuse() {
+    SlabPool& pool = SlabPool::Instance();
+    void* first = pool.allocate(300);
+    pool.deallocate(first, 300);
+    const auto before = pool.Stats();
+    void* second = pool.allocate(300);
+    const auto after = pool.Stats();
+    ASSERT_TRUE("freed block is reused", first == second);
+    ASSERT_EQUAL("served from magazine", after.hits - before.hits, static_cast<std::size_t>(1));
+    ASSERT_EQUAL("no depot refill", after.refills, before.refills);
+    ASSERT_TRUE("block alignment", reinterpret_cast<std::uintptr_t>(second) % SlabPool::BlockAlignment == 0);
+    pool.deallocate(second, 300);
+
+    void* large = pool.allocate(SlabPool::MaxBlock * 2);
+    pool.deallocate(large, SlabPool::MaxBlock * 2);
+    ASSERT_EQUAL("large requests go upstream", pool.Stats().large_allocations - after.large_allocations, static_cast<std::size_t>(1));
+    RETURN_TEST("test_slab_pool_magazine_reuse", 0);
+}
+
+int test_slab_pool_thread_exit_flush() {
+    SlabPool& pool = SlabPool::Instance();
+    const auto before = pool.Stats();
+    std::thread worker([&pool] {
+        std::vector<void*> blocks;
+        for (int i = 0; i < 1000; ++i) blocks.push_back(pool.allocate(256));
+        for (void* p : blocks) pool.deallocate(p, 256);
+    });
+    worker.join();
+    const auto after = pool.Stats();
+    ASSERT_EQUAL("exited thread returned its magazines", after.outstanding_bytes, before.outstanding_bytes);
+    ASSERT_EQUAL("exited thread counters kept", after.allocations - before.allocations, static_cast<std::size_t>(1000));
+    ASSERT_TRUE("high water covers the burst", after.high_water_bytes >= 1000 * 256);
+    ASSERT_TRUE("mostly magazine hits", static_cast<double>(after.hits - before.hits) / 1000.0 > 0.9);
+    RETURN_TEST("test_slab_pool_thread_exit_flush", 0);
+}
+
+int test_slab_pool_backs_buffers() {
+    SlabPool& pool = SlabPool::Instance();
+    const auto before = pool.Stats();
+    {
+        FIFO fifo(&pool);
+        for (int i = 0; i < 100; ++i) fifo.Write(std::string(100, 'x'));
+        auto data = fifo.Extract(0, &pool);
+        ASSERT_TRUE("extract", data.has_value() && data->size() == 10000);
+
+        Pipeline pipeline(&pool);
+        pipeline.AddPipe([](Consumer in, Producer out, std::shared_ptr<StormByte::Logger>) {
+            while (!in.EoF()) {
+                auto chunk = in.Extract(0);
+                if (chunk && !chunk->empty()) out.Write(*chunk);
+            }
+            out.Close();
+        });
+        Producer input;
+        input.Write("pooled");
+        input.Close();
+        Consumer result = pipeline.Process(input.Consumer(), ExecutionMode::Async, nullptr);
+        while (!result.EoF() && result.AvailableBytes() < 6) std::this_thread::yield();
+        auto output = result.Extract(0);
+        ASSERT_EQUAL("pipeline output", StormByte::String::FromByteVector(*output), std::string("pooled"));
+    }
+    const auto after = pool.Stats();
+    ASSERT_TRUE("buffers allocated from the pool", after.allocations > before.allocations);
+    RETURN_TEST("test_slab_pool_backs_buffers", 0);
+}
+
+int main() {
+    int result = 0;
+    result += test_slab_pool_size_classes();
+    result += test_slab_pool_magazine_reuse();
+    result += test_slab_pool_thread_exit_flush();
+    result += test_slab_pool_backs_buffers();
+
+    if (result == 0) {
+        std::cout << "SlabPool tests passed!" << std::endl;
+    } else {
+        std::cout << result << " SlabPool tests failed." << std::endl;
+    }
+    return result;
+}
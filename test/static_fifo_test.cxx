@@ -0,0 +1,132 @@
+#include <StormByte/buffer/static_fifo.hxx>
+#include <StormByte/string.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <array>
+#include <iostream>
+#include <string>
+
+using StormByte::Buffer::Position;
+using StormByte::Buffer::StaticFIFO;
+
+namespace {
+    std::string toString(std::span<const std::byte> bytes) {
+        return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    // Frames are parsed at compile time to keep the class constexpr friendly
+    constexpr std::size_t compile_time_roundtrip() {
+        StaticFIFO<8> fifo;
+        (void)fifo.Write("abcdef");
+        std::array<std::byte, 4> out {};
+        (void)fifo.Extract(std::span<std::byte>(out));
+        (void)fifo.Write("ghijkl"); // wraps around
+        return fifo.Size() * 10 + static_cast<std::size_t>(fifo.Full());
+    }
+    static_assert(compile_time_roundtrip() == 81);
+}
+
+int test_static_fifo_write_read_extract() {
+    StaticFIFO<16> fifo;
+    ASSERT_TRUE("empty", fifo.Empty());
+    ASSERT_EQUAL("capacity", StaticFIFO<16>::Capacity(), static_cast<std::size_t>(16));
+    ASSERT_TRUE("write", fifo.Write("Hello World").has_value());
+    ASSERT_EQUAL("size", fifo.Size(), static_cast<std::size_t>(11));
+
+    auto read = fifo.Read(5);
+    ASSERT_TRUE("read", read.has_value());
+    ASSERT_EQUAL("read content", StormByte::String::FromByteVector(*read), std::string("Hello"));
+    ASSERT_EQUAL("read is non-destructive", fifo.Size(), static_cast<std::size_t>(11));
+    fifo.Seek(6, Position::Absolute);
+    ASSERT_EQUAL("read after seek", StormByte::String::FromByteVector(*fifo.Read(0)), std::string("World"));
+    fifo.Seek(-5, Position::Relative);
+    ASSERT_EQUAL("available after relative seek", fifo.AvailableBytes(), static_cast<std::size_t>(5));
+
+    auto extracted = fifo.Extract(6);
+    ASSERT_EQUAL("extract content", StormByte::String::FromByteVector(*extracted), std::string("Hello "));
+    ASSERT_EQUAL("read position follows extract", fifo.AvailableBytes(), static_cast<std::size_t>(5));
+    RETURN_TEST("test_static_fifo_write_read_extract", 0);
+}
+
+int test_static_fifo_overflow() {
+    StaticFIFO<8> fifo;
+    ASSERT_TRUE("fits", fifo.Write("12345").has_value());
+    auto overflow = fifo.Write("6789");
+    ASSERT_FALSE("overflow rejected", overflow.has_value());
+    ASSERT_EQUAL("nothing written on overflow", fifo.Size(), static_cast<std::size_t>(5));
+    ASSERT_TRUE("exact fit", fifo.Write("678").has_value());
+    ASSERT_TRUE("full", fifo.Full());
+    ASSERT_FALSE("full rejects", fifo.Write("9").has_value());
+    fifo.Close();
+    (void)fifo.Extract(0);
+    ASSERT_FALSE("closed rejects", fifo.Write("x").has_value());
+    RETURN_TEST("test_static_fifo_overflow", 0);
+}
+
+int test_static_fifo_wrap_around() {
+    // 12 is not a power of two, 16 is: both wrap paths
+    StaticFIFO<12> odd;
+    StaticFIFO<16> even;
+    auto run = [](auto& fifo) -> std::string {
+        std::string result;
+        for (int round = 0; round < 10; ++round) {
+            (void)fifo.Write("abcdefg");
+            std::array<std::byte, 7> out {};
+            auto n = fifo.Extract(std::span<std::byte>(out));
+            if (!n || *n != 7) return "extract failed";
+            result = toString(std::span<const std::byte>(out.data(), *n));
+        }
+        return result;
+    };
+    ASSERT_EQUAL("non power of two", run(odd), std::string("abcdefg"));
+    ASSERT_EQUAL("power of two", run(even), std::string("abcdefg"));
+
+    // Read across the end of the storage
+    StaticFIFO<8> fifo;
+    (void)fifo.Write("012345");
+    (void)fifo.Extract(4);
+    (void)fifo.Write("6789ab");
+    std::array<std::byte, 8> out {};
+    auto n = fifo.Read(std::span<std::byte>(out));
+    ASSERT_TRUE("span read", n.has_value());
+    ASSERT_EQUAL("span read content", toString(std::span<const std::byte>(out.data(), *n)), std::string("456789ab"));
+    fifo.Seek(2, Position::Absolute);
+    fifo.Clean();
+    ASSERT_EQUAL("clean", StormByte::String::FromByteVector(*fifo.Extract(0)), std::string("6789ab"));
+    RETURN_TEST("test_static_fifo_wrap_around", 0);
+}
+
+int test_static_fifo_errors() {
+    StaticFIFO<8> fifo;
+    std::array<std::byte, 4> out {};
+    ASSERT_FALSE("extract on empty", fifo.Extract(std::span<std::byte>(out)).has_value());
+    auto none = fifo.Extract(std::span<std::byte>());
+    ASSERT_TRUE("empty span asks for nothing", none.has_value() && *none == 0);
+    (void)fifo.Write("ab");
+    auto partial = fifo.Read(std::span<std::byte>(out));
+    ASSERT_TRUE("partial read while open", partial.has_value() && *partial == 2);
+    fifo.Close();
+    fifo.Seek(0, Position::Absolute);
+    ASSERT_FALSE("closed insufficient", fifo.Read(std::span<std::byte>(out)).has_value());
+    ASSERT_FALSE("not eof", fifo.EoF());
+    (void)fifo.Extract(0);
+    ASSERT_TRUE("eof", fifo.EoF());
+    fifo.SetError();
+    ASSERT_FALSE("unreadable", fifo.Read(0).has_value());
+    RETURN_TEST("test_static_fifo_errors", 0);
+}
+
+int main() {
+    int result = 0;
+    result += test_static_fifo_write_read_extract();
+    result += test_static_fifo_overflow();
+    result += test_static_fifo_wrap_around();
+    result += test_static_fifo_errors();
+
+    if (result == 0) {
+        std::cout << "StaticFIFO tests passed!" << std::endl;
+    } else {
+        std::cout << result << " StaticFIFO tests failed." << std::endl;
+    }
+    return result;
+}